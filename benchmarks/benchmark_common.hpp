@@ -0,0 +1,48 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_parallel;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers shared by the benchmarks: owning handlers, generated nodes that are
+// linear or rect depending on the tree, and fastest-run timing.
+// ─────────────────────────────────────────────────────────────────────────────
+namespace ufox::geometry::discadelta::benchmarks {
+
+    template<typename ContextT>
+    using ContextHandler = std::unique_ptr<ContextT, decltype(&DestroySegmentContext<ContextT>)>;
+
+    // A rect node gets the same size on both axes; `column` only matters for rects
+    template<typename ContextT>
+    ContextHandler<ContextT> MakeNode(const std::string& name, const float base, const float min, const float max, const bool column, const size_t order) {
+        if constexpr (std::same_as<ContextT, LinearSegmentContext>) {
+            return CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+                .name = name, .base = base, .flexCompress = 0.5f, .flexExpand = 1.0f, .min = min, .max = max, .order = order});
+        }
+        else {
+            return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                .name = name, .width = base, .widthMin = min, .widthMax = max,
+                .height = base, .heightMin = min, .heightMax = max,
+                .direction = column ? FlexDirection::Column : FlexDirection::Row,
+                .flexCompress = 0.5f, .flexExpand = 1.0f, .order = order});
+        }
+    }
+
+    template<typename ContextT>
+    float GetMainBase(const ContextT& ctx) noexcept {
+        if constexpr (std::same_as<ContextT, LinearSegmentContext>) return ctx.accumulatedBase;
+        else return ctx.accumulatedWidthBase;
+    }
+
+    template<typename FuncT>
+    double MeasureFastestMicros(const size_t repeats, FuncT&& func) {
+        return static_cast<double>(MeasureFastestRun(repeats, func)) / 1000.0;
+    }
+
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+#include "benchmark_common.hpp"
+
+using namespace ufox::geometry::discadelta;
+using namespace ufox::geometry::discadelta::benchmarks;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Churn soak: repeatedly destroys, creates and moves list rows of a generated
+// tree, and tracks RSS, heap allocations and Sizing/Placing time over time, so
+// allocator and storage changes can be judged on fragmentation and locality.
+//
+// The defaults churn 128k rows, about half an hour of one row change per frame
+// at 60 fps; raise the cycle count for longer sessions.
+//
+// Usage: churn_soak_benchmark [linear|rect] [cycles] [panels] [rows per panel] [churn per cycle] [report interval]
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> deallocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+}
+
+void* operator new(const std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    deallocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+// Over-aligned types allocate through these, so they are counted too
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+#if defined(_MSC_VER)
+    if (void* ptr = _aligned_malloc(rounded, align)) return ptr;
+#else
+    if (void* ptr = std::aligned_alloc(align, rounded)) return ptr;
+#endif
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    if (ptr == nullptr) return;
+    deallocationCount.fetch_add(1, std::memory_order_relaxed);
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, std::size_t, const std::align_val_t alignment) noexcept {
+    operator delete(ptr, alignment);
+}
+
+struct SoakConfig {
+    bool rect{false};
+    size_t cycles{2000};
+    size_t panels{16};
+    size_t rowsPerPanel{256};
+    size_t churnPerCycle{64};
+    size_t reportInterval{100};
+    size_t timingRepeats{5};
+};
+
+struct SoakSample {
+    size_t cycle{0};
+    double rssMiB{0.0};
+    uint64_t liveAllocations{0};
+    double allocationsPerCycle{0.0};
+    double bytesPerCycle{0.0};
+    double sizingMicros{0.0};
+    double placingMicros{0.0};
+};
+
+double ReadResidentMiB() {
+#if defined(__linux__)
+    if (FILE* file = std::fopen("/proc/self/statm", "r")) {
+        unsigned long long size = 0;
+        unsigned long long resident = 0;
+        const int read = std::fscanf(file, "%llu %llu", &size, &resident);
+        std::fclose(file);
+        if (read == 2) return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+    }
+#endif
+    return 0.0;
+}
+
+template<typename ContextT>
+void Size(ContextT& root, const float input) {
+    if constexpr (std::same_as<ContextT, LinearSegmentContext>) Sizing(root, input, 0.0f, true);
+    else Sizing(root, input, 1080.0f, 0.0f, 0.0f, true);
+}
+
+void PrintSample(const SoakSample& sample, const SoakSample& first) {
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(8) << sample.cycle
+              << " | " << std::setw(9) << sample.rssMiB
+              << " | " << std::setw(10) << sample.liveAllocations
+              << " | " << std::setw(11) << std::setprecision(1) << sample.allocationsPerCycle
+              << " | " << std::setw(11) << sample.bytesPerCycle
+              << " | " << std::setw(10) << sample.sizingMicros << " (x" << std::setprecision(2) << sample.sizingMicros / first.sizingMicros << ")"
+              << " | " << std::setw(10) << std::setprecision(1) << sample.placingMicros << " (x" << std::setprecision(2) << sample.placingMicros / first.placingMicros << ")"
+              << "\n";
+}
+
+template<typename ContextT>
+void RunSoak(const SoakConfig& config) {
+    constexpr float unbounded = std::numeric_limits<float>::max();
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> baseDistribution(20.0f, 80.0f);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> panelDistribution(0, config.panels - 1);
+
+    size_t serial = 0;
+    const auto makeRow = [&] {
+        const float base = baseDistribution(random);
+        const float min = serial % 3 == 0 ? base * 0.5f : 0.0f;
+        const float max = serial % 5 == 0 ? base * 2.0f : unbounded;
+        auto row = MakeNode<ContextT>("Row_" + std::to_string(serial), base, min, max, false, serial);
+        ++serial;
+        return row;
+    };
+
+    auto root = MakeNode<ContextT>("Root", 0.0f, 0.0f, unbounded, false, 0);
+    std::vector<ContextHandler<ContextT>> panels;
+    std::vector<ContextHandler<ContextT>> rows;
+    rows.reserve(config.panels * config.rowsPerPanel);
+
+    for (size_t p = 0; p < config.panels; ++p) {
+        auto panel = MakeNode<ContextT>("Panel_" + std::to_string(p), 0.0f, 0.0f, unbounded, true, p);
+        for (size_t r = 0; r < config.rowsPerPanel; ++r) {
+            auto row = makeRow();
+            Link(*panel, *row);
+            rows.push_back(std::move(row));
+        }
+        Link(*root, *panel);
+        panels.push_back(std::move(panel));
+    }
+
+    const auto sample = [&](const size_t cycle, const uint64_t allocationsBefore, const uint64_t bytesBefore, const size_t cycles) {
+        SoakSample result{.cycle = cycle, .rssMiB = ReadResidentMiB()};
+        const uint64_t allocations = allocationCount.load(std::memory_order_relaxed);
+        result.liveAllocations = allocations - deallocationCount.load(std::memory_order_relaxed);
+        result.allocationsPerCycle = cycles == 0 ? 0.0 : static_cast<double>(allocations - allocationsBefore) / static_cast<double>(cycles);
+        result.bytesPerCycle = cycles == 0 ? 0.0 : static_cast<double>(allocatedBytes.load(std::memory_order_relaxed) - bytesBefore) / static_cast<double>(cycles);
+
+        const float input = GetMainBase(*root) * 0.9f;
+        result.sizingMicros = MeasureFastestMicros(config.timingRepeats, [&] { Size(*root, input); });
+        result.placingMicros = MeasureFastestMicros(config.timingRepeats, [&] { Placing(*root); });
+        return result;
+    };
+
+    std::cout << "   cycle |  RSS MiB  | live allocs | allocs/cycle | bytes/cycle |   Sizing us          |  Placing us\n";
+
+    const SoakSample first = sample(0, 0, 0, 0);
+    PrintSample(first, first);
+
+    SoakSample last = first;
+    uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    uint64_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+
+    for (size_t cycle = 1; cycle <= config.cycles; ++cycle) {
+        for (size_t op = 0; op < config.churnPerCycle; ++op) {
+            const size_t index = std::uniform_int_distribution<size_t>(0, rows.size() - 1)(random);
+            ContextT& target = *panels[panelDistribution(random)];
+
+            if (chance(random) < 0.25f) {
+                // Move an existing row to another panel
+                Unlink(*rows[index]);
+                Link(target, *rows[index]);
+            }
+            else {
+                // Destroy a row and replace it with a freshly created one
+                rows[index] = makeRow();
+                Link(target, *rows[index]);
+            }
+        }
+
+        Size(*root, GetMainBase(*root) * 0.9f);
+        Placing(*root);
+
+        if (cycle % config.reportInterval == 0 || cycle == config.cycles) {
+            const size_t elapsed = cycle - last.cycle;
+            last = sample(cycle, allocationsBefore, bytesBefore, elapsed);
+            PrintSample(last, first);
+
+            allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "\nRSS: " << first.rssMiB << " -> " << last.rssMiB << " MiB"
+              << " | live allocations: " << first.liveAllocations << " -> " << last.liveAllocations
+              << " | Sizing: x" << last.sizingMicros / first.sizingMicros
+              << " | Placing: x" << last.placingMicros / first.placingMicros
+              << " | rows churned: " << serial - config.panels * config.rowsPerPanel << "\n";
+}
+
+int main(const int argc, char** argv) {
+    SoakConfig config;
+    if (argc > 1) config.rect = std::string_view{argv[1]} == "rect";
+    if (argc > 2) config.cycles = std::max<size_t>(1, std::strtoull(argv[2], nullptr, 10));
+    if (argc > 3) config.panels = std::max<size_t>(1, std::strtoull(argv[3], nullptr, 10));
+    if (argc > 4) config.rowsPerPanel = std::max<size_t>(1, std::strtoull(argv[4], nullptr, 10));
+    if (argc > 5) config.churnPerCycle = std::strtoull(argv[5], nullptr, 10);
+    if (argc > 6) config.reportInterval = std::max<size_t>(1, std::strtoull(argv[6], nullptr, 10));
+
+    std::cout << "Churn soak benchmark (" << (config.rect ? "Rect" : "Linear") << " tree)\n"
+              << "cycles: " << config.cycles << " | panels: " << config.panels
+              << " | rows per panel: " << config.rowsPerPanel
+              << " | churn per cycle: " << config.churnPerCycle << "\n\n";
+
+    if (config.rect) RunSoak<RectSegmentContext>(config);
+    else RunSoak<LinearSegmentContext>(config);
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+#include "benchmark_common.hpp"
+
+using namespace ufox::geometry::discadelta;
+using namespace ufox::geometry::discadelta::benchmarks;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Interactive resize latency: replays a synthetic window-edge drag against large
+// trees through UpdateSegments and reports per-frame tail latency.
+//
+// Usage: resize_latency_benchmark [frames] [panels] [rows per panel] [edit interval]
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct BenchmarkConfig {
+    size_t frames{20000};
+    size_t panels{64};
+    size_t rowsPerPanel{64};
+    size_t editInterval{8};
+    size_t warmupFrames{200};
+    size_t worstFrames{10};
+    float crossInput{1080.0f};
+    float dragBand{400.0f};
+};
+
+struct FrameRecord {
+    size_t frame{0};
+    int64_t nanoseconds{0};
+    float input{0.0f};
+    bool crossed{false};
+    const void* moved{nullptr};
+    const void* from{nullptr};
+    const void* to{nullptr};
+    std::vector<const void*> flipped;
+};
+
+template<typename ContextT>
+struct BenchmarkTree {
+    ContextHandler<ContextT> root{nullptr, &DestroySegmentContext<ContextT>};
+    std::vector<ContextHandler<ContextT>> panels;
+    std::vector<ContextHandler<ContextT>> rows;
+};
+
+template<typename ContextT>
+BenchmarkTree<ContextT> BuildTree(const BenchmarkConfig& config, std::mt19937& random) {
+    constexpr float unbounded = std::numeric_limits<float>::max();
+    std::uniform_real_distribution<float> baseDistribution(20.0f, 80.0f);
+
+    BenchmarkTree<ContextT> tree;
+    tree.root = MakeNode<ContextT>("Root", 0.0f, 0.0f, unbounded, false, 0);
+
+    for (size_t p = 0; p < config.panels; ++p) {
+        auto panel = MakeNode<ContextT>("Panel_" + std::to_string(p), 0.0f, 0.0f, unbounded, true, p);
+
+        for (size_t r = 0; r < config.rowsPerPanel; ++r) {
+            const float base = baseDistribution(random);
+            const float min = r % 3 == 0 ? base * 0.5f : 0.0f;
+            const float max = r % 5 == 0 ? base * 2.0f : unbounded;
+            auto row = MakeNode<ContextT>("Row_" + std::to_string(p) + "_" + std::to_string(r), base, min, max, false, r);
+
+            Link(*panel, *row);
+            tree.rows.push_back(std::move(row));
+        }
+
+        Link(*tree.root, *panel);
+        tree.panels.push_back(std::move(panel));
+    }
+
+    return tree;
+}
+
+template<typename ContextT>
+bool IsCompressing(const ContextT& ctx) noexcept {
+    if constexpr (std::same_as<ContextT, LinearSegmentContext>) return ctx.content.distance < ctx.accumulatedBase;
+    else {
+        // A context is compressed along the main axis of the row or column it sits in
+        const FlexDirection axis = ctx.parent != nullptr ? ctx.parent->config.direction : ctx.config.direction;
+        if (axis == FlexDirection::Row) return ctx.content.width < ctx.accumulatedWidthBase;
+        return ctx.content.height < ctx.accumulatedHeightBase;
+    }
+}
+
+template<typename ContextT>
+void Solve(ContextT& root, const float input, const BenchmarkConfig& config) {
+    if constexpr (std::same_as<ContextT, LinearSegmentContext>) UpdateSegments(root, input, true);
+    else UpdateSegments(root, input, config.crossInput, true);
+}
+
+int64_t Percentile(const std::vector<int64_t>& sorted, const double fraction) {
+    if (sorted.empty()) return 0;
+    const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void PrintLatencies(const std::string& label, std::vector<int64_t> latencies) {
+    std::ranges::sort(latencies);
+
+    const auto micro = [](const int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << std::left << std::setw(14) << label << std::right
+              << " frames: " << std::setw(7) << latencies.size()
+              << " | p50: " << std::setw(8) << micro(Percentile(latencies, 0.5)) << " us"
+              << " | p99: " << std::setw(8) << micro(Percentile(latencies, 0.99)) << " us"
+              << " | p99.9: " << std::setw(8) << micro(Percentile(latencies, 0.999)) << " us"
+              << " | max: " << std::setw(8) << micro(latencies.empty() ? 0 : latencies.back()) << " us\n";
+}
+
+template<typename ContextT>
+void RunScenario(const std::string& title, const BenchmarkConfig& config) {
+    std::mt19937 random(42);
+    BenchmarkTree<ContextT> tree = BuildTree<ContextT>(config, random);
+    ContextT& root = *tree.root;
+
+    const auto nameOf = [](const void* ctx) { return static_cast<const ContextT*>(ctx)->config.name; };
+
+    // The drag oscillates around the point where the root switches between compressing and expanding
+    const float crossing = GetMainBase(root);
+    const float lower = std::max(0.0f, crossing - config.dragBand);
+    const float upper = crossing + config.dragBand;
+    std::uniform_real_distribution<float> stepDistribution(1.0f, 6.0f);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> rowDistribution(0, tree.rows.size() - 1);
+    std::uniform_int_distribution<size_t> panelDistribution(0, tree.panels.size() - 1);
+
+    float input = std::max(lower, crossing - config.dragBand * 0.5f);
+    float direction = 1.0f;
+
+    // Whether the root and every panel compress their children, to report which nodes flipped mode
+    std::vector<const ContextT*> watched{&root};
+    for (const auto& panel : tree.panels) watched.push_back(panel.get());
+    std::vector<bool> compressing(watched.size(), false);
+
+    std::vector<FrameRecord> records;
+    records.reserve(config.frames);
+
+    for (size_t frame = 0; frame < config.warmupFrames + config.frames; ++frame) {
+        if (chance(random) < 0.02f) direction = -direction;
+        const float previous = input;
+        input += direction * stepDistribution(random);
+        if (input < lower || input > upper) {
+            direction = -direction;
+            input = std::clamp(input, lower, upper);
+        }
+
+        FrameRecord record{.frame = frame, .input = input, .crossed = (previous < crossing) != (input < crossing)};
+
+        ContextT* moved = nullptr;
+        ContextT* target = nullptr;
+        if (config.editInterval != 0 && frame % config.editInterval == 0) {
+            moved = tree.rows[rowDistribution(random)].get();
+            const size_t panel = panelDistribution(random);
+            target = tree.panels[panel].get();
+            if (target == moved->parent) target = tree.panels[(panel + 1) % tree.panels.size()].get();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (moved != nullptr) {
+            record.moved = moved;
+            record.from = moved->parent;
+            record.to = target;
+            Unlink(*moved);
+            Link(*target, *moved);
+        }
+        Solve(root, input, config);
+
+        record.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        for (size_t i = 0; i < watched.size(); ++i) {
+            const bool now = IsCompressing(*watched[i]);
+            if (now != compressing[i] && frame > 0) record.flipped.push_back(watched[i]);
+            compressing[i] = now;
+        }
+
+        if (frame >= config.warmupFrames) records.push_back(std::move(record));
+    }
+
+    std::vector<int64_t> all;
+    std::vector<int64_t> resizeOnly;
+    std::vector<int64_t> withEdit;
+    std::vector<int64_t> crossings;
+    for (const auto& record : records) {
+        all.push_back(record.nanoseconds);
+        (record.moved != nullptr ? withEdit : resizeOnly).push_back(record.nanoseconds);
+        if (record.crossed) crossings.push_back(record.nanoseconds);
+    }
+
+    std::cout << "=== " << title << " (" << root.branchCount << " nodes, " << records.size() << " frames) ===\n";
+    PrintLatencies("all", all);
+    PrintLatencies("resize only", resizeOnly);
+    PrintLatencies("link/unlink", withEdit);
+    PrintLatencies("mode crossing", crossings);
+
+    std::ranges::sort(records, std::greater<>{}, &FrameRecord::nanoseconds);
+    records.resize(std::min(records.size(), config.worstFrames));
+
+    std::cout << "  worst frames:\n";
+    for (const auto& record : records) {
+        std::cout << "    #" << std::setw(6) << record.frame - config.warmupFrames
+                  << " | " << std::setw(8) << static_cast<double>(record.nanoseconds) / 1000.0 << " us"
+                  << " | input: " << std::setw(8) << record.input
+                  << (record.crossed ? " | compress/expand crossing" : "");
+        if (record.moved != nullptr) {
+            std::cout << " | moved " << nameOf(record.moved)
+                      << ": " << (record.from != nullptr ? nameOf(record.from) : std::string{"(none)"})
+                      << " -> " << nameOf(record.to);
+        }
+        if (!record.flipped.empty()) {
+            std::cout << " | mode flipped:";
+            for (size_t i = 0; i < std::min<size_t>(record.flipped.size(), 4); ++i) std::cout << " " << nameOf(record.flipped[i]);
+            if (record.flipped.size() > 4) std::cout << " (+" << record.flipped.size() - 4 << " more)";
+        }
+        if (record.moved == nullptr && record.flipped.empty()) {
+            std::cout << " | resize only, no mode change";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main(const int argc, char** argv) {
+    BenchmarkConfig config;
+    if (argc > 1) config.frames = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) config.panels = std::max<size_t>(1, std::strtoull(argv[2], nullptr, 10));
+    if (argc > 3) config.rowsPerPanel = std::max<size_t>(1, std::strtoull(argv[3], nullptr, 10));
+    if (argc > 4) config.editInterval = std::strtoull(argv[4], nullptr, 10);
+
+    std::cout << "Interactive resize latency benchmark\n"
+              << "frames: " << config.frames << " | panels: " << config.panels
+              << " | rows per panel: " << config.rowsPerPanel
+              << " | link/unlink every " << config.editInterval << " frames\n\n";
+
+    RunScenario<LinearSegmentContext>("Linear tree", config);
+    RunScenario<RectSegmentContext>("Rect tree", config);
+
+    return 0;
+}
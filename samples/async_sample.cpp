@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_async;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Latest-wins background layout.
+//
+// A burst of resize requests is issued faster than the service can solve a
+// few thousand nodes, so most solves are cancelled. Each future must resolve
+// to a result at or after its own request, carrying the sizes of the request
+// it was solved for, and the final published result must equal a synchronous
+// solve of the live tree for the last request.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t panelCount = 48;
+constexpr size_t rowsPerPanel = 64;
+constexpr size_t requestCount = 32;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width, const float height, const float min, const FlexDirection direction, const size_t order) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMin = min, .widthMax = unbounded, .height = height, .heightMin = min, .heightMax = unbounded,
+            .direction = direction, .flexCompress = 1.0f, .flexExpand = 1.0f, .order = order});
+}
+
+int main() {
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(MakeRect("Root", 0.0f, 0.0f, 0.0f, FlexDirection::Row, 0));
+
+    for (size_t panel = 0; panel < panelCount; ++panel) {
+        auto panelCtx = MakeRect("Panel" + std::to_string(panel), 40.0f + static_cast<float>(panel % 7) * 10.0f, 0.0f, 20.0f, FlexDirection::Column, panel);
+        for (size_t row = 0; row < rowsPerPanel; ++row) {
+            auto rowCtx = MakeRect(panelCtx->config.name + "Row" + std::to_string(row), unbounded, 12.0f + static_cast<float>(row % 5) * 4.0f,
+                                   row % 3 == 0 ? 10.0f : 0.0f, FlexDirection::Row, row);
+            Link(*panelCtx, *rowCtx);
+            nodes.push_back(std::move(rowCtx));
+        }
+        Link(*nodes.front(), *panelCtx);
+        nodes.push_back(std::move(panelCtx));
+    }
+
+    RectSegmentContext& root = *nodes.front();
+    std::vector<SegmentLayoutRequest> requests(requestCount);
+    for (size_t i = 0; i < requestCount; ++i) {
+        requests[i] = SegmentLayoutRequest{.mainInput = 1200.0f + static_cast<float>(i) * 37.0f, .crossInput = 700.0f + static_cast<float>(i % 4) * 50.0f, .round = i % 2 == 0};
+    }
+
+    bool passed = true;
+    {
+        RectAsyncLayoutService service;
+
+        std::vector<std::future<RectAsyncLayoutService::Result>> futures;
+        for (const SegmentLayoutRequest& request : requests) futures.push_back(service.Request(root, request));
+
+        size_t stale = 0;
+        for (size_t i = 0; i < futures.size(); ++i) {
+            const auto result = futures[i].get();
+            const uint64_t ownId = i + 1;
+            if (result == nullptr || result->requestId < ownId || result->requestId > requestCount) {
+                ++stale;
+                continue;
+            }
+
+            const SegmentLayoutRequest& solvedFor = requests[result->requestId - 1];
+            if (result->request.mainInput != solvedFor.mainInput || result->request.crossInput != solvedFor.crossInput) ++stale;
+        }
+        std::cout << "Requests: " << requestCount << " | stale results: " << stale << "\n";
+        passed = stale == 0;
+
+        const auto latest = service.Latest();
+        passed = passed && latest != nullptr && latest->requestId == requestCount;
+
+        // The published snapshot against a synchronous solve of the live tree
+        const SegmentLayoutRequest& last = requests.back();
+        UpdateSegments(root, last.mainInput, last.crossInput, last.round);
+
+        size_t index = 0;
+        size_t mismatches = latest != nullptr && latest->nodes.size() == nodes.size() ? 0 : 1;
+        for (const auto& [ctx, depth] : TraversePreOrder(root)) {
+            if (latest == nullptr || index >= latest->nodes.size()) break;
+            const RectSegment& a = latest->nodes[index++].content;
+            const RectSegment& b = ctx->content;
+            if (a.width != b.width || a.height != b.height || a.x != b.x || a.y != b.y) ++mismatches;
+        }
+        std::cout << "Latest request id: " << (latest != nullptr ? latest->requestId : 0)
+                  << " | nodes: " << index << " | mismatches against a synchronous solve: " << mismatches << "\n";
+        passed = passed && mismatches == 0;
+    }
+
+    std::cout << (passed ? "Latest-wins layout matches the synchronous solve" : "Latest-wins layout MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
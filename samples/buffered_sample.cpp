@@ -0,0 +1,105 @@
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Buffered solves of one indexed tree, for several sizes on several threads.
+//
+// The tree is indexed once and only read while worker threads solve it into
+// their own result buffers, with and without rounding, for sizes that compress
+// and expand it past the min and max of some children. Each buffer must then
+// match a sequential UpdateSegments of the same size, context by context.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t panelCount = 6;
+constexpr size_t rowsPerPanel = 5;
+constexpr size_t workerCount = 4;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+struct SolveSize {
+    float mainInput;
+    float crossInput;
+    bool round;
+};
+
+int main() {
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = "Root", .widthMax = unbounded, .height = unbounded, .heightMax = unbounded,
+            .direction = FlexDirection::Row, .flexCompress = 1.0f, .flexExpand = 1.0f}));
+
+    // Even panels are clamped from below, every third one from above
+    for (size_t panel = 0; panel < panelCount; ++panel) {
+        const float width = 80.0f + static_cast<float>(panel) * 23.0f;
+        auto panelCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                .name = "Panel" + std::to_string(panel), .width = width, .widthMin = panel % 2 == 0 ? width * 0.8f : 0.0f,
+                .widthMax = panel % 3 == 0 ? width * 1.25f : unbounded, .height = unbounded, .heightMax = unbounded,
+                .direction = FlexDirection::Column, .flexCompress = 0.5f + static_cast<float>(panel % 3) * 0.5f,
+                .flexExpand = 1.0f + static_cast<float>(panel % 2), .order = panelCount - panel});
+        panelCtx->order = panelCount - panel;
+
+        for (size_t row = 0; row < rowsPerPanel; ++row) {
+            const float height = 24.0f + static_cast<float>((panel * 7 + row * 5) % 11) * 4.0f;
+            auto rowCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                    .name = panelCtx->config.name + "Row" + std::to_string(row), .width = width, .widthMax = unbounded,
+                    .height = height, .heightMin = row % 2 == 0 ? height : 0.0f, .heightMax = row % 3 == 1 ? height * 1.5f : unbounded,
+                    .flexCompress = 1.0f, .flexExpand = 1.0f, .order = row});
+            Link(*panelCtx, *rowCtx);
+            nodes.push_back(std::move(rowCtx));
+        }
+        Link(*nodes.front(), *panelCtx);
+        nodes.push_back(std::move(panelCtx));
+    }
+
+    RectSegmentContext& root = *nodes.front();
+    const size_t count = IndexSegmentResults(root);
+
+    std::vector<SolveSize> sizes;
+    for (const float mainInput : {317.0f, 641.5f, 803.0f, 1297.3f}) {
+        for (const bool round : {false, true}) sizes.push_back({mainInput, 150.0f + mainInput * 0.25f, round});
+    }
+
+    std::vector<std::vector<RectSegment>> results(sizes.size(), std::vector<RectSegment>(count));
+    {
+        std::vector<std::jthread> workers;
+        for (size_t worker = 0; worker < workerCount; ++worker) {
+            workers.emplace_back([&, worker] {
+                for (size_t i = worker; i < sizes.size(); i += workerCount) {
+                    SolveSegmentResults(root, sizes[i].mainInput, sizes[i].crossInput, sizes[i].round, std::span(results[i]));
+                }
+            });
+        }
+    }
+
+    bool passed = count == nodes.size();
+    size_t clamped = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        UpdateSegments(root, sizes[i].mainInput, sizes[i].crossInput, sizes[i].round);
+
+        size_t mismatches = 0;
+        for (const auto& [ctx, depth] : TraversePreOrder(root)) {
+            const RectSegment& a = results[i][ctx->resultIndex];
+            const RectSegment& b = ctx->content;
+            if (a.width != b.width || a.height != b.height || a.x != b.x || a.y != b.y) ++mismatches;
+            if ((ctx->config.widthMin > 0.0f && b.width == ctx->config.widthMin) || b.width == ctx->config.widthMax
+                || (ctx->config.heightMin > 0.0f && b.height == ctx->config.heightMin) || b.height == ctx->config.heightMax) ++clamped;
+        }
+        std::cout << "Size " << sizes[i].mainInput << "x" << sizes[i].crossInput << (sizes[i].round ? " rounded" : "")
+                  << " | mismatches: " << mismatches << "\n";
+        passed = passed && mismatches == 0;
+    }
+
+    std::cout << "Clamped results: " << clamped << "\n";
+    passed = passed && clamped > 0;
+
+    std::cout << (passed ? "Buffered solves match UpdateSegments" : "Buffered solves MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
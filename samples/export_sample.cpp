@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_export;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Quantized instance export of a placed rect tree.
+//
+// The tree is indexed, solved with rounding and exported to packed instances,
+// whole and leaves only. Every instance must carry the placed rect of the node
+// at the same step of the placement-order walk, its depth below the root and
+// its pre-order index as node id.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width, const float height, const FlexDirection direction, const size_t order) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMax = unbounded, .height = height, .heightMax = unbounded,
+            .direction = direction, .flexCompress = 1.0f, .flexExpand = 1.0f, .order = order});
+}
+
+// Counts the instances that do not match the walk they were staged from
+template<typename TraversalT>
+size_t CountMismatches(TraversalT&& traversal, const std::span<const RectInstance> instances, size_t& visited) {
+    size_t mismatches = 0;
+    visited = 0;
+    for (const auto& [ctx, depth] : traversal) {
+        if (visited >= instances.size()) {
+            ++mismatches;
+            continue;
+        }
+
+        const RectInstance& instance = instances[visited++];
+        const RectSegment& content = ctx->content;
+        if (instance.x != static_cast<int16_t>(content.x) || instance.y != static_cast<int16_t>(content.y)
+            || instance.width != static_cast<uint16_t>(content.width) || instance.height != static_cast<uint16_t>(content.height)
+            || instance.depth != depth || instance.nodeId != ctx->resultIndex) ++mismatches;
+    }
+    return mismatches;
+}
+
+int main() {
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(MakeRect("Root", 0.0f, 0.0f, FlexDirection::Row, 0));
+
+    // Placement order differs from link order, so node ids are not just the instance positions
+    for (size_t column = 0; column < 3; ++column) {
+        auto columnCtx = MakeRect("Column" + std::to_string(column), 100.0f + static_cast<float>(column) * 50.0f, 0.0f, FlexDirection::Column, 2 - column);
+        columnCtx->order = 2 - column;
+        for (size_t cell = 0; cell < 2 + column; ++cell) {
+            auto cellCtx = MakeRect(columnCtx->config.name + "Cell" + std::to_string(cell), 1000.0f, 40.0f + static_cast<float>(cell) * 20.0f, FlexDirection::Row, cell);
+            Link(*columnCtx, *cellCtx);
+            nodes.push_back(std::move(cellCtx));
+        }
+        Link(*nodes.front(), *columnCtx);
+        nodes.push_back(std::move(columnCtx));
+    }
+
+    RectSegmentContext& root = *nodes.front();
+    const size_t count = IndexSegmentResults(root);
+    UpdateSegments(root, 901.0f, 433.0f, true);
+
+    RectExportBuffer staging;
+    std::vector<RectInstance> instances(count);
+    bool passed = true;
+
+    for (const bool leavesOnly : {false, true}) {
+        const size_t written = ExportRectInstances(root, staging, std::span(instances), leavesOnly);
+        const auto exported = std::span<const RectInstance>(instances).first(written);
+
+        size_t visited = 0;
+        const size_t mismatches = leavesOnly
+            ? CountMismatches(TraversePlacedLeaves(root), exported, visited)
+            : CountMismatches(TraversePlacementOrder(root), exported, visited);
+
+        std::cout << (leavesOnly ? "Leaves" : "Tree  ") << " | instances: " << written << " | walked: " << visited
+                  << " | mismatches: " << mismatches << "\n";
+        for (const RectInstance& instance : exported) {
+            std::cout << "  id " << instance.nodeId << " | depth " << instance.depth
+                      << " | x: " << instance.x << " | y: " << instance.y
+                      << " | w: " << instance.width << " | h: " << instance.height << "\n";
+        }
+
+        // Every node of the tree gets its own id
+        std::vector<bool> seen(count, false);
+        bool idsDistinct = true;
+        for (const RectInstance& instance : exported) {
+            if (instance.nodeId >= count || seen[instance.nodeId]) idsDistinct = false;
+            else seen[instance.nodeId] = true;
+        }
+
+        passed = passed && mismatches == 0 && idsDistinct && written == visited && (leavesOnly || written == count);
+    }
+
+    std::cout << (passed ? "Instance export matches the placed tree" : "Instance export MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_flat;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Single-level solve with caller-owned buffers (no tree, no per-segment allocation)
+// Same segments as the chapter 3 sample
+// ─────────────────────────────────────────────────────────────────────────────
+void PrintFlatResults(const std::vector<LinearSegmentCreateInfo>& configs, const std::vector<LinearSegment>& results) noexcept {
+    float total{0.0f};
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& res = results[i];
+        total += res.distance;
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << configs[i].name
+                  << " | distance: " << res.distance
+                  << " | offset: "   << res.offset
+                  << " | base: "     << res.base
+                  << " | expandDelta: " << res.expandDelta
+                  << "\n";
+    }
+
+    std::cout << "Total: " << total << "\n";
+}
+
+int main() {
+    const std::vector<LinearSegmentCreateInfo> configs{
+        {"Segment_1", 200.0f, 0.7f, 0.1f, 0.0f, 100.0f, 2},
+        {"Segment_2", 200.0f, 1.0f, 1.0f, 300.0f, 800.0f, 1},
+        {"Segment_3", 150.0f, 0.0f, 2.0f, 0.0f, 200.0f, 3},
+        {"Segment_4", 350.0f, 0.3f, 0.5f, 50.0f, 300.0f, 0}};
+
+    // Buffers are owned by the caller and reused across pre-compute and solve calls
+    FlatPreComputeMetrics metrics;
+    std::vector<LinearSegment> results(configs.size());
+
+    PreComputeFlatMetrics(configs, metrics);
+
+    for (const float distance : {500.0f, 800.0f, 1200.0f}) {
+        const bool compressed = SolveFlatSegments(metrics, distance, false, results);
+
+        std::cout << std::defaultfloat << "=== Flat Solve (size " << distance << ", " << (compressed ? "compress" : "expand") << ") ===\n";
+        PrintFlatResults(configs, results);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
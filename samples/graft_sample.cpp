@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Panels built and pre-computed on worker threads, then grafted onto one root
+// in a single call, checked against the same panels linked one at a time.
+// Both trees must count the same branches and solve to the same rects.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t panelCount = 8;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+using Panel = std::vector<RectSegmentContextHandler>;
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width, const float height, const float min, const FlexDirection direction, const size_t order) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMin = min, .widthMax = unbounded,
+            .height = height, .heightMin = min, .heightMax = unbounded,
+            .direction = direction, .flexCompress = 1.0f, .flexExpand = 1.0f, .order = order});
+}
+
+// A column of rows of cells; the first entry is the panel root
+Panel BuildPanel(const size_t index) {
+    Panel panel;
+    panel.push_back(MakeRect("Panel" + std::to_string(index), 200.0f, 0.0f, 40.0f, FlexDirection::Column, index));
+
+    const size_t rowCount = 2 + index % 3;
+    for (size_t row = 0; row < rowCount; ++row) {
+        const std::string rowName = panel.front()->config.name + "Row" + std::to_string(row);
+        auto rowCtx = MakeRect(rowName, 0.0f, 30.0f + static_cast<float>(row) * 10.0f, 0.0f, FlexDirection::Row, row);
+        Link(*panel.front(), *rowCtx);
+
+        for (size_t cell = 0; cell < 3 + row; ++cell) {
+            auto cellCtx = MakeRect(rowName + "Cell" + std::to_string(cell), 20.0f + static_cast<float>(cell * 15), 0.0f,
+                                    cell % 2 == 0 ? 10.0f : 0.0f, FlexDirection::Row, cell);
+            Link(*rowCtx, *cellCtx);
+            panel.push_back(std::move(cellCtx));
+        }
+        panel.push_back(std::move(rowCtx));
+    }
+    return panel;
+}
+
+std::vector<const RectSegmentContext*> CollectPreOrder(const RectSegmentContext& root) {
+    std::vector<const RectSegmentContext*> nodes;
+    for (const auto& [ctx, depth] : TraversePreOrder(root)) nodes.push_back(ctx);
+    return nodes;
+}
+
+int main() {
+    auto graftedRoot = MakeRect("Root", 0.0f, 0.0f, 0.0f, FlexDirection::Row, 0);
+    auto linkedRoot = MakeRect("Root", 0.0f, 0.0f, 0.0f, FlexDirection::Row, 0);
+
+    // Each worker builds and pre-computes its own disjoint panel
+    std::vector<Panel> graftedPanels(panelCount);
+    {
+        std::vector<std::jthread> workers;
+        for (size_t i = 0; i < panelCount; ++i) {
+            workers.emplace_back([&graftedPanels, i] { graftedPanels[i] = BuildPanel(i); });
+        }
+    }
+
+    std::vector<RectSegmentContext*> subtrees;
+    for (const auto& panel : graftedPanels) subtrees.push_back(panel.front().get());
+    Graft(*graftedRoot, std::span<RectSegmentContext* const>(subtrees));
+
+    std::vector<Panel> linkedPanels;
+    for (size_t i = 0; i < panelCount; ++i) {
+        linkedPanels.push_back(BuildPanel(i));
+        Link(*linkedRoot, *linkedPanels.back().front());
+    }
+
+    std::cout << "Grafted branchCount: " << graftedRoot->branchCount
+              << " | linked branchCount: " << linkedRoot->branchCount << "\n";
+    bool passed = graftedRoot->branchCount == linkedRoot->branchCount;
+
+    for (const auto& [width, height, round] : {std::tuple{1280.0f, 720.0f, false}, std::tuple{600.0f, 300.0f, true}}) {
+        UpdateSegments(*graftedRoot, width, height, round);
+        UpdateSegments(*linkedRoot, width, height, round);
+
+        const auto grafted = CollectPreOrder(*graftedRoot);
+        const auto linked = CollectPreOrder(*linkedRoot);
+
+        size_t mismatches = grafted.size() == linked.size() ? 0 : 1;
+        for (size_t i = 0; i < std::min(grafted.size(), linked.size()); ++i) {
+            const RectSegment& a = grafted[i]->content;
+            const RectSegment& b = linked[i]->content;
+            if (grafted[i]->config.name != linked[i]->config.name || grafted[i]->branchCount != linked[i]->branchCount
+                || a.width != b.width || a.height != b.height || a.x != b.x || a.y != b.y) ++mismatches;
+        }
+
+        std::cout << "Size " << width << "x" << height << (round ? " (rounded)" : "")
+                  << " | nodes: " << grafted.size() << " | mismatches: " << mismatches << "\n";
+        passed = passed && mismatches == 0;
+    }
+
+    std::cout << (passed ? "Graft matches Link" : "Graft MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -5,24 +5,23 @@
 
 import ufox_discadelta_lib;
 import ufox_discadelta_core;
+import ufox_discadelta_traversal;
 
 using namespace ufox::geometry::discadelta;
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Debug print for LinearSegmentContext tree (1D version)
-// Prints name, distance, offset, and indents children
+// Prints name, distance, offset, and indents children by depth
 // ─────────────────────────────────────────────────────────────────────────────
-void PrintTreeDebugWithOffset(const LinearSegmentContext& ctx, int indent = 0) noexcept {
-    std::string pad(indent * 4, ' ');
-    std::cout << pad << ctx.config.name
-              << " | distance: " << ctx.content.distance
-              << " | offset: "   << ctx.content.offset
-              << " | base: "     << ctx.content.base
-              << " | expandDelta: " << ctx.content.expandDelta
-              << "\n";
-
-    for (const auto* child : ctx.children) {
-        PrintTreeDebugWithOffset(*child, indent + 1);
+void PrintTreeDebugWithOffset(const LinearSegmentContext& root) noexcept {
+    for (const auto& [ctx, depth] : TraversePreOrder(root)) {
+        std::string pad(depth * 4, ' ');
+        std::cout << pad << ctx->config.name
+                  << " | distance: " << ctx->content.distance
+                  << " | offset: "   << ctx->content.offset
+                  << " | base: "     << ctx->content.base
+                  << " | expandDelta: " << ctx->content.expandDelta
+                  << "\n";
     }
 }
 
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_export;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Level-of-detail placement and export of a rect tree with sub-pixel panels.
+//
+// Placing with a threshold must place the small panels themselves but leave
+// their subtrees untouched, and place everything else exactly like a full
+// placement. StageRectExportLOD must then emit one entry per visible context
+// and one merged entry per run of small siblings, spanning the run's bounding
+// box and counting every context of the run's subtrees, so the segment counts
+// add up to the whole tree.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float unbounded = std::numeric_limits<float>::max();
+constexpr float threshold = 1.0f;
+constexpr float untouched = -7.0f;
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width, const float height, const float expand, const FlexDirection direction) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMax = unbounded, .height = height, .heightMax = unbounded,
+            .direction = direction, .flexCompress = 1.0f, .flexExpand = expand});
+}
+
+// One expected entry: a single context, or a run of siblings from `first` to `last`
+struct ExpectedEntry {
+    const RectSegmentContext* first;
+    const RectSegmentContext* last;
+    size_t depth;
+    uint32_t segmentCount;
+};
+
+int main() {
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(MakeRect("Root", 0.0f, unbounded, 1.0f, FlexDirection::Row));
+    RectSegmentContext& root = *nodes.front();
+
+    // Panels 1, 2 and 4 are narrower than the threshold; panel 3 holds two rows shorter than it
+    const std::vector<float> panelWidths{200.0f, 0.4f, 0.3f, 150.0f, 0.5f};
+    const std::vector<std::vector<float>> rowHeights{{40.0f, 50.0f, 60.0f}, {30.0f, 30.0f}, {30.0f, 30.0f},
+                                                     {45.0f, 0.5f, 0.25f, 55.0f}, {30.0f, 30.0f}};
+    std::vector<RectSegmentContext*> panels;
+    std::vector<std::vector<RectSegmentContext*>> rows(panelWidths.size());
+    for (size_t panel = 0; panel < panelWidths.size(); ++panel) {
+        const bool smallPanel = panelWidths[panel] < threshold;
+        nodes.push_back(MakeRect("Panel" + std::to_string(panel), panelWidths[panel], unbounded, smallPanel ? 0.0f : 1.0f, FlexDirection::Column));
+        panels.push_back(nodes.back().get());
+
+        for (size_t row = 0; row < rowHeights[panel].size(); ++row) {
+            const float height = rowHeights[panel][row];
+            nodes.push_back(MakeRect(panels.back()->config.name + "Row" + std::to_string(row), panelWidths[panel], height, height < threshold ? 0.0f : 1.0f, FlexDirection::Row));
+            rows[panel].push_back(nodes.back().get());
+            Link(*panels.back(), *rows[panel].back());
+        }
+        Link(root, *panels.back());
+    }
+
+    // Full solve as the reference, then a LOD placement over a marked tree
+    UpdateSegments(root, 800.0f, 300.0f, false);
+    std::vector<RectSegment> full;
+    for (const auto& node : nodes) full.push_back(node->content);
+
+    for (const auto& node : nodes) {
+        node->content.x = untouched;
+        node->content.y = untouched;
+    }
+    Placing(root, 0.0f, 0.0f, threshold);
+
+    size_t skipped = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const RectSegmentContext* ctx = nodes[i].get();
+        const bool belowSmallPanel = ctx->parent != nullptr && ctx->parent != &root && IsBelowDetailThreshold(*ctx->parent, threshold);
+        if (belowSmallPanel) {
+            if (ctx->content.x == untouched && ctx->content.y == untouched) ++skipped;
+            else ++mismatches;
+        }
+        else if (ctx->content.x != full[i].x || ctx->content.y != full[i].y) ++mismatches;
+    }
+    std::cout << "LOD placement | skipped: " << skipped << " of 6 | mismatches against a full placement: " << mismatches << "\n";
+    bool passed = skipped == 6 && mismatches == 0;
+
+    const std::vector<ExpectedEntry> expected{
+            {&root, &root, 0, 1},
+            {panels[0], panels[0], 1, 1},
+            {rows[0][0], rows[0][0], 2, 1},
+            {rows[0][1], rows[0][1], 2, 1},
+            {rows[0][2], rows[0][2], 2, 1},
+            {panels[1], panels[2], 1, 6},
+            {panels[3], panels[3], 1, 1},
+            {rows[3][0], rows[3][0], 2, 1},
+            {rows[3][1], rows[3][2], 2, 2},
+            {rows[3][3], rows[3][3], 2, 1},
+            {panels[4], panels[4], 1, 3}};
+
+    RectLodExportBuffer buffer;
+    const size_t staged = StageRectExportLOD(root, buffer, threshold);
+
+    mismatches = staged == expected.size() ? 0 : 1;
+    size_t totalSegments = 0;
+    for (const uint32_t count : buffer.segmentCount) totalSegments += count;
+
+    for (size_t i = 0; i < std::min(staged, expected.size()); ++i) {
+        const ExpectedEntry& entry = expected[i];
+        // A merged run spans the bounding box of its siblings; a single entry is the context's own rect
+        RectSegment span = entry.first->content;
+        if (entry.first != entry.last) {
+            float right = span.x + span.width, bottom = span.y + span.height;
+            const auto& siblings = entry.first->parent->children;
+            for (auto it = std::ranges::find(siblings, entry.first); it != siblings.end(); ++it) {
+                const RectSegment& content = (*it)->content;
+                span.x = std::min(span.x, content.x);
+                span.y = std::min(span.y, content.y);
+                right = std::max(right, content.x + content.width);
+                bottom = std::max(bottom, content.y + content.height);
+                if (*it == entry.last) break;
+            }
+            span.width = right - span.x;
+            span.height = bottom - span.y;
+        }
+
+        const RectExportBuffer& rects = buffer.rects;
+        if (rects.x[i] != span.x || rects.y[i] != span.y || rects.width[i] != span.width || rects.height[i] != span.height
+            || rects.depth[i] != entry.depth || buffer.segmentCount[i] != entry.segmentCount) ++mismatches;
+    }
+    std::cout << "LOD export | entries: " << staged << " of " << root.branchCount << " contexts | segments: " << totalSegments
+              << " | mismatches: " << mismatches << "\n";
+    passed = passed && mismatches == 0 && totalSegments == root.branchCount;
+
+    std::cout << (passed ? "LOD export aggregates the small runs" : "LOD export MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
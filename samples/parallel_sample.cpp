@@ -0,0 +1,146 @@
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_parallel;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Batched, level-parallel recompute checked against per-node recompute.
+//
+// Two identical trees are built: one with Link, which recomputes every edit on
+// the spot, and one with Attach followed by a single RecomputeDirtyMetrics over
+// the whole dirty set. A batch of config edits is then applied to both the same
+// way. Every accumulated metric and priority list must match after each phase.
+// Finally the trees are solved with forced and with calibrated strategies:
+// ParallelUpdateSegments must produce the same segments as UpdateSegments.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t groupCount = 16;
+constexpr size_t leavesPerGroup = 64;
+constexpr size_t workerCount = 4;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+struct Tree {
+    std::vector<LinearSegmentContextHandler> nodes;
+};
+
+LinearSegmentCreateInfo MakeLeafConfig(const size_t group, const size_t leaf) {
+    const float base = 10.0f + static_cast<float>((group * 37 + leaf * 11) % 90);
+    return LinearSegmentCreateInfo{
+        .name = "Leaf" + std::to_string(group) + "_" + std::to_string(leaf), .base = base,
+        .flexCompress = 0.25f + static_cast<float>(leaf % 4) * 0.25f, .flexExpand = 1.0f,
+        .min = leaf % 3 == 0 ? base * 0.5f : 0.0f, .max = leaf % 5 == 0 ? base * 1.5f : unbounded, .order = leaf};
+}
+
+// Nodes are stored root first, then each group followed by its leaves
+Tree BuildTree(const bool batched) {
+    Tree tree;
+    tree.nodes.push_back(CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+            .name = "Root", .flexCompress = 1.0f, .flexExpand = 1.0f, .max = unbounded, .order = 0}));
+    LinearSegmentContext& root = *tree.nodes.front();
+
+    for (size_t group = 0; group < groupCount; ++group) {
+        tree.nodes.push_back(CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+                .name = "Group" + std::to_string(group), .flexCompress = 1.0f, .flexExpand = 1.0f, .max = unbounded, .order = group}));
+        LinearSegmentContext& groupCtx = *tree.nodes.back();
+        if (batched) Attach(root, groupCtx);
+        else Link(root, groupCtx);
+
+        for (size_t leaf = 0; leaf < leavesPerGroup; ++leaf) {
+            tree.nodes.push_back(CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>(MakeLeafConfig(group, leaf)));
+            if (batched) Attach(groupCtx, *tree.nodes.back());
+            else Link(groupCtx, *tree.nodes.back());
+        }
+    }
+    return tree;
+}
+
+size_t CountMismatches(const Tree& expected, const Tree& actual) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < expected.nodes.size(); ++i) {
+        const LinearSegmentContext& a = *expected.nodes[i];
+        const LinearSegmentContext& b = *actual.nodes[i];
+        if (a.accumulatedBase != b.accumulatedBase || a.accumulatedMin != b.accumulatedMin
+            || a.accumulatedCompressSolidify != b.accumulatedCompressSolidify || a.accumulatedExpandRatio != b.accumulatedExpandRatio
+            || a.validatedBase != b.validatedBase || a.validatedMin != b.validatedMin || a.validatedMax != b.validatedMax
+            || a.compressCascadePriorities != b.compressCascadePriorities || a.expandCascadePriorities != b.expandCascadePriorities
+            || a.compressUnconstrained != b.compressUnconstrained || a.expandUnconstrained != b.expandUnconstrained
+            || a.strategy != b.strategy) ++mismatches;
+    }
+    return mismatches;
+}
+
+int main() {
+    Tree linked = BuildTree(false);
+    Tree batched = BuildTree(true);
+
+    std::vector<LinearSegmentContext*> dirty;
+    for (const auto& node : batched.nodes) dirty.push_back(node.get());
+    size_t recomputed = RecomputeDirtyMetrics(std::span<LinearSegmentContext* const>(dirty), workerCount);
+
+    size_t mismatches = CountMismatches(linked, batched);
+    std::cout << "Build | recomputed: " << recomputed << " of " << batched.nodes.size()
+              << " | mismatches: " << mismatches << "\n";
+    bool passed = mismatches == 0 && recomputed == batched.nodes.size();
+
+    // Edit every seventh leaf; both trees change the same configs
+    dirty.clear();
+    for (size_t i = 1; i < linked.nodes.size(); ++i) {
+        if (linked.nodes[i]->children.empty() && i % 7 == 0) {
+            for (Tree* tree : {&linked, &batched}) {
+                LinearSegmentCreateInfo& config = tree->nodes[i]->config;
+                config.base *= 1.5f;
+                config.min = config.base * 0.75f;
+                config.flexCompress = 0.1f;
+            }
+            UpdateContextMetrics(*linked.nodes[i]);
+            dirty.push_back(batched.nodes[i].get());
+        }
+    }
+
+    recomputed = RecomputeDirtyMetrics(std::span<LinearSegmentContext* const>(dirty), workerCount);
+    mismatches = CountMismatches(linked, batched);
+    std::cout << "Edit  | dirty: " << dirty.size() << " | recomputed: " << recomputed
+              << " | mismatches: " << mismatches << "\n";
+    passed = passed && mismatches == 0 && recomputed == dirty.size() + groupCount + 1;
+
+    // Parallel descent on every branching node, then wherever the host calibration picks it
+    for (const auto& [label, thresholds, forced] : {std::tuple{"Forced", SegmentStrategyThresholds{.parallelBranchCount = 2}, true},
+                                                    std::tuple{"Calibrated", CalibrateSegmentStrategies(workerCount), false}}) {
+        SetSegmentStrategyThresholds(thresholds);
+        dirty.clear();
+        for (const auto& node : batched.nodes) dirty.push_back(node.get());
+        RecomputeDirtyMetrics(std::span<LinearSegmentContext* const>(dirty), workerCount);
+
+        size_t parallelNodes = 0;
+        for (const auto& node : batched.nodes) {
+            if (node->strategy == SegmentSolveStrategy::ParallelDescent) ++parallelNodes;
+        }
+
+        mismatches = 0;
+        const float accumulatedBase = linked.nodes.front()->accumulatedBase;
+        for (const float inputDistance : {accumulatedBase * 0.6f, accumulatedBase * 1.7f}) {
+            for (const bool round : {false, true}) {
+                UpdateSegments(*linked.nodes.front(), inputDistance, round);
+                ParallelUpdateSegments(*batched.nodes.front(), inputDistance, round, workerCount);
+                for (size_t i = 0; i < linked.nodes.size(); ++i) {
+                    const LinearSegment& a = linked.nodes[i]->content;
+                    const LinearSegment& b = batched.nodes[i]->content;
+                    if (a.distance != b.distance || a.offset != b.offset) ++mismatches;
+                }
+            }
+        }
+        std::cout << "Solve | " << label << " | parallel nodes: " << parallelNodes << " | mismatches: " << mismatches << "\n";
+        passed = passed && mismatches == 0 && (!forced || parallelNodes == groupCount + 1);
+    }
+    SetSegmentStrategyThresholds({});
+
+    std::cout << (passed ? "Batched recompute matches per-node updates" : "Batched recompute MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_reclaim;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Epoch-based reclamation of contexts retired while a reader is inside.
+//
+// A reader enters a read epoch and keeps a pointer to a panel. The writer then
+// retires that panel and another one, and reclaims. Neither may be freed while
+// the reader is inside, even after it leaves a nested epoch, and the reader
+// must still see the retired panel's data; both are freed by the first
+// reclaim after ExitReadEpoch. A context retired before the reader entered is
+// freed right away.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMax = unbounded, .height = unbounded, .heightMax = unbounded,
+            .direction = FlexDirection::Column, .flexCompress = 1.0f, .flexExpand = 1.0f});
+}
+
+int main() {
+    SegmentReclaimDomain domain;
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(MakeRect("Root", 0.0f));
+    RectSegmentContext& root = *nodes.front();
+    root.config.direction = FlexDirection::Row;
+
+    for (size_t panel = 0; panel < 4; ++panel) {
+        nodes.push_back(MakeRect("Panel" + std::to_string(panel), 100.0f + static_cast<float>(panel) * 10.0f));
+        Link(root, *nodes.back());
+    }
+    UpdateSegments(root, 800.0f, 600.0f, false);
+
+    SegmentReaderSlot* slot = AcquireReaderSlot(domain);
+    bool passed = slot != nullptr;
+    if (!passed) {
+        std::cout << "No reader slot" << std::endl;
+        return 1;
+    }
+
+    // Retired before the reader enters: nothing can hold it
+    RetireSegmentContext(domain, nodes[4]);
+    const size_t freedBefore = ReclaimSegmentContexts(domain);
+    std::cout << "Retired outside | freed: " << freedBefore << " | pending: " << GetPendingRetiredCount(domain) << "\n";
+    passed = passed && freedBefore == 1 && GetPendingRetiredCount(domain) == 0;
+
+    EnterReadEpoch(domain, *slot);
+    EnterReadEpoch(domain, *slot);
+    const RectSegmentContext* held = nodes[1].get();
+    const float heldWidth = held->content.width;
+
+    RetireSegmentContext(domain, nodes[1]);
+    RetireSegmentContext(domain, nodes[2]);
+    const size_t freedInside = ReclaimSegmentContexts(domain);
+
+    ExitReadEpoch(*slot);
+    const size_t freedNested = ReclaimSegmentContexts(domain);
+    const bool readable = held->config.name == "Panel0" && held->content.width == heldWidth && held->parent == nullptr;
+    std::cout << "Retired inside | freed inside: " << freedInside << " | freed after a nested exit: " << freedNested
+              << " | pending: " << GetPendingRetiredCount(domain) << " | still readable: " << (readable ? "yes" : "no") << "\n";
+    passed = passed && freedInside == 0 && freedNested == 0 && GetPendingRetiredCount(domain) == 2 && readable;
+
+    ExitReadEpoch(*slot);
+    const size_t freedAfter = ReclaimSegmentContexts(domain);
+    std::cout << "Reader left | freed: " << freedAfter << " | pending: " << GetPendingRetiredCount(domain)
+              << " | root children: " << root.children.size() << "\n";
+    passed = passed && freedAfter == 2 && GetPendingRetiredCount(domain) == 0 && root.children.size() == 1;
+
+    ReleaseReaderSlot(slot);
+
+    std::cout << (passed ? "Retired contexts outlive the read epoch" : "Reclamation MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
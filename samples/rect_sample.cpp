@@ -1,28 +1,29 @@
 import ufox_discadelta_lib;
 import ufox_discadelta_core;
+import ufox_discadelta_traversal;
 
 #include <cmath>
 #include <iostream>
+#include <string>
 #include <thread>
+#include <vector>
 
 
 using namespace ufox::geometry::discadelta;
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Debug print for RectSegmentContext tree (2D version)
-// Prints name, width/height, x/y, and indents children
+// Prints name, width/height, x/y, and indents children by depth
 // ─────────────────────────────────────────────────────────────────────────────
-void PrintTreeDebugWithOffset(const RectSegmentContext& ctx, int indent = 0) noexcept {
-    std::string pad(indent * 4, ' ');
-    std::cout << pad << ctx.config.name
-              << " | w: " << ctx.content.width
-              << " | h: " << ctx.content.height
-              << " | x: " << ctx.content.x
-              << " | y: " << ctx.content.y
-              << "\n";
-
-    for (const auto* child : ctx.children) {
-        PrintTreeDebugWithOffset(*child, indent + 1);
+void PrintTreeDebugWithOffset(const RectSegmentContext& root) noexcept {
+    for (const auto& [ctx, depth] : TraversePreOrder(root)) {
+        std::string pad(depth * 4, ' ');
+        std::cout << pad << ctx->config.name
+                  << " | w: " << ctx->content.width
+                  << " | h: " << ctx->content.height
+                  << " | x: " << ctx->content.x
+                  << " | y: " << ctx->content.y
+                  << "\n";
     }
 }
 
@@ -103,5 +104,53 @@ int main() {
 
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
-    return 0;
+    // ────────────────────────────────────────────────────────────────
+    // Third test: a compressed row weighs each child by its own compress
+    // capacity, so it splits exactly like the equivalent linear segment,
+    // with the default proportional policy and with integer weights
+    // ────────────────────────────────────────────────────────────────
+    constexpr float unbounded = std::numeric_limits<float>::max();
+    constexpr float widths[] = {120.0f, 80.0f, 60.0f};
+    constexpr float flexes[] = {1.0f, 0.5f, 0.25f};
+
+    bool rowsMatch = true;
+    for (const DistributionMode mode : {DistributionMode::Proportional, DistributionMode::IntegerWeighted}) {
+        const std::string modeName = mode == DistributionMode::Proportional ? "Proportional" : "Integer weighted";
+
+        auto row = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                .name = "Row", .widthMax = unbounded, .heightMax = unbounded,
+                .direction = FlexDirection::Row, .flexCompress = 1.0f, .flexExpand = 1.0f,
+                .distribution = mode});
+        auto line = CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+                .name = "Line", .flexCompress = 1.0f, .flexExpand = 1.0f, .max = unbounded, .order = 0,
+                .distribution = mode});
+
+        std::vector<decltype(row)> rectCells;
+        std::vector<decltype(line)> lineCells;
+        for (size_t i = 0; i < std::size(widths); ++i) {
+            rectCells.push_back(CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                    .name = "Cell" + std::to_string(i), .width = widths[i], .widthMax = unbounded,
+                    .height = 40.0f, .heightMax = unbounded, .flexCompress = flexes[i], .flexExpand = 1.0f, .order = i}));
+            lineCells.push_back(CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+                    .name = "Cell" + std::to_string(i), .base = widths[i], .flexCompress = flexes[i], .flexExpand = 1.0f,
+                    .max = unbounded, .order = i}));
+            Link(*row, *rectCells.back());
+            Link(*line, *lineCells.back());
+        }
+
+        Sizing(*row, 200.0f, 40.0f, 0.0f, 0.0f, false);
+        Sizing(*line, 200.0f, 0.0f, false);
+
+        std::cout << "\n\n=== " << modeName << " row (size 200x40) ===" << std::endl;
+        for (size_t i = 0; i < rectCells.size(); ++i) {
+            const float rectWidth = rectCells[i]->content.width;
+            const float lineDistance = lineCells[i]->content.distance;
+            std::cout << rectCells[i]->config.name << " | w: " << rectWidth << " | linear: " << lineDistance << "\n";
+            if (std::abs(rectWidth - lineDistance) > 1e-3f) rowsMatch = false;
+            if (i > 0 && std::abs(rectWidth - rectCells[i - 1]->content.width) < 1e-3f) rowsMatch = false;
+        }
+    }
+    std::cout << (rowsMatch ? "Compressed rows match the linear cascade" : "Compressed rows MISMATCH") << std::endl;
+
+    return rowsMatch ? 0 : 1;
 }
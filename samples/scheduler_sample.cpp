@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_scheduler;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// One frame of mixed edits through a RectFrameScheduler.
+//
+// Several resizes, config invalidations, scheduled links and unlinks are
+// collected and flushed together. The frame must solve once, recompute every
+// affected context exactly once and count the coalesced requests, and the
+// result must match a reference tree edited with Link/Unlink directly. The
+// next frame has nothing pending and must stay idle.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t panelCount = 3;
+constexpr size_t rowsPerPanel = 4;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+// Root first, then the panels, then the rows of each panel, then one spare row
+struct Tree {
+    std::vector<RectSegmentContextHandler> nodes;
+
+    RectSegmentContext& Root() const { return *nodes.front(); }
+    RectSegmentContext& Panel(const size_t panel) const { return *nodes[1 + panel]; }
+    RectSegmentContext& Row(const size_t panel, const size_t row) const { return *nodes[1 + panelCount + panel * rowsPerPanel + row]; }
+    RectSegmentContext& Spare() const { return *nodes.back(); }
+};
+
+RectSegmentContextHandler MakeRect(const std::string& name, const float width, const float height, const FlexDirection direction, const size_t order) {
+    return CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = name, .width = width, .widthMax = unbounded, .height = height, .heightMax = unbounded,
+            .direction = direction, .flexCompress = 1.0f, .flexExpand = 1.0f, .order = order});
+}
+
+Tree BuildTree() {
+    Tree tree;
+    tree.nodes.push_back(MakeRect("Root", 0.0f, 0.0f, FlexDirection::Row, 0));
+    for (size_t panel = 0; panel < panelCount; ++panel) {
+        tree.nodes.push_back(MakeRect("Panel" + std::to_string(panel), 120.0f + static_cast<float>(panel) * 40.0f, 0.0f, FlexDirection::Column, panel));
+        Link(tree.Root(), *tree.nodes.back());
+    }
+    for (size_t panel = 0; panel < panelCount; ++panel) {
+        for (size_t row = 0; row < rowsPerPanel; ++row) {
+            tree.nodes.push_back(MakeRect("Panel" + std::to_string(panel) + "Row" + std::to_string(row), unbounded, 30.0f + static_cast<float>(row) * 5.0f, FlexDirection::Row, row));
+            Link(tree.Panel(panel), *tree.nodes.back());
+        }
+    }
+    tree.nodes.push_back(MakeRect("Spare", unbounded, 25.0f, FlexDirection::Row, rowsPerPanel));
+    return tree;
+}
+
+int main() {
+    Tree scheduled = BuildTree();
+    Tree reference = BuildTree();
+
+    RectFrameScheduler scheduler{.root = &scheduled.Root()};
+    RequestResize(scheduler, 800.0f, 600.0f, false);
+    FlushFrame(scheduler);
+    UpdateSegments(reference.Root(), 800.0f, 600.0f, false);
+
+    // One frame of edits
+    RequestResize(scheduler, 1024.0f, 600.0f, false);
+    RequestResize(scheduler, 1100.0f, 640.0f, false);
+    RequestResize(scheduler, 1280.0f, 720.0f, true);
+
+    for (Tree* tree : {&scheduled, &reference}) {
+        tree->Row(0, 1).config.height = 90.0f;
+        tree->Panel(1).config.width = 260.0f;
+    }
+    Invalidate(scheduler, scheduled.Row(0, 1));
+    Invalidate(scheduler, scheduled.Row(0, 1));
+    Invalidate(scheduler, scheduled.Panel(1));
+    ScheduleLink(scheduler, scheduled.Panel(1), scheduled.Spare());
+    ScheduleUnlink(scheduler, scheduled.Row(2, 3));
+    ScheduleLink(scheduler, scheduled.Panel(2), scheduled.Row(0, 2));
+
+    UpdateContextMetrics(reference.Row(0, 1));
+    UpdateContextMetrics(reference.Panel(1));
+    Link(reference.Panel(1), reference.Spare());
+    Unlink(reference.Row(2, 3));
+    Link(reference.Panel(2), reference.Row(0, 2));
+
+    // Every invalidated context and its ancestors, each once
+    std::unordered_set<const RectSegmentContext*> affected;
+    for (const RectSegmentContext* ctx : scheduler.dirty) {
+        for (; ctx != nullptr; ctx = ctx->parent) affected.insert(ctx);
+    }
+    const uint64_t requests = scheduler.pending.invalidations + scheduler.pending.resizeRequests;
+
+    const bool solved = FlushFrame(scheduler);
+    UpdateSegments(reference.Root(), 1280.0f, 720.0f, true);
+
+    const SegmentSchedulerStats& busy = scheduler.lastFrame;
+    std::cout << "Busy frame | solved: " << (solved ? "yes" : "no") << " | solves: " << busy.solves
+              << " | resizes: " << busy.resizeRequests << " | invalidations: " << busy.invalidations
+              << " | recomputed: " << busy.recomputedContexts << " of " << affected.size()
+              << " | coalesced: " << busy.coalescedRequests << "\n";
+    bool passed = solved && busy.solves == 1 && busy.resizeRequests == 3
+                  && busy.recomputedContexts == affected.size() && busy.coalescedRequests == requests - 1;
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < scheduled.nodes.size(); ++i) {
+        const RectSegment& a = scheduled.nodes[i]->content;
+        const RectSegment& b = reference.nodes[i]->content;
+        if (a.width != b.width || a.height != b.height || a.x != b.x || a.y != b.y) ++mismatches;
+    }
+    std::cout << "Layout against direct edits | mismatches: " << mismatches << "\n";
+    passed = passed && mismatches == 0;
+
+    const bool solvedIdle = FlushFrame(scheduler);
+    const SegmentSchedulerStats& idle = scheduler.lastFrame;
+    std::cout << "Idle frame | solved: " << (solvedIdle ? "yes" : "no") << " | idle: " << idle.idleFrames
+              << " | recomputed: " << idle.recomputedContexts << " | total frames: " << scheduler.total.frames
+              << " | total solves: " << scheduler.total.solves << "\n";
+    passed = passed && !solvedIdle && idle.idleFrames == 1 && idle.solves == 0 && idle.recomputedContexts == 0
+             && scheduler.total.frames == 3 && scheduler.total.solves == 2;
+
+    std::cout << (passed ? "Scheduler coalesces the frame into one solve" : "Scheduler MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+import ufox_discadelta_lib;
+import ufox_discadelta_shm;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Shared-memory rect ring between two processes on one machine
+// The parent publishes frames while a forked reader acquires and validates them;
+// every frame that validates must hold exactly the values of its sequence
+// ─────────────────────────────────────────────────────────────────────────────
+#if defined(__unix__) || defined(__APPLE__)
+constexpr uint32_t rectCount = 256;
+constexpr uint64_t frameCount = 20000;
+
+void FillFrame(RectExportBuffer& staged, const uint64_t sequence) {
+    for (uint32_t i = 0; i < rectCount; ++i) {
+        staged.x[i] = static_cast<float>(sequence);
+        staged.y[i] = static_cast<float>(i);
+        staged.width[i] = static_cast<float>(sequence * 2);
+        staged.height[i] = static_cast<float>(sequence + i);
+        staged.nodeId[i] = i;
+        staged.depth[i] = static_cast<uint16_t>(sequence);
+    }
+}
+
+bool CheckFrame(const SharedRectFrame& frame) {
+    if (frame.x.size() != rectCount) return false;
+
+    for (uint32_t i = 0; i < rectCount; ++i) {
+        if (frame.x[i] != static_cast<float>(frame.sequence)
+            || frame.y[i] != static_cast<float>(i)
+            || frame.width[i] != static_cast<float>(frame.sequence * 2)
+            || frame.height[i] != static_cast<float>(frame.sequence + i)
+            || frame.nodeId[i] != i
+            || frame.depth[i] != static_cast<uint16_t>(frame.sequence)) return false;
+    }
+    return true;
+}
+
+// Runs in the forked process; the exit status reports the outcome
+int RunReader(const std::string& name) {
+    auto ring = OpenSharedRectRing(name);
+    if (!ring) return 2;
+
+    uint64_t last = 0;
+    uint64_t consistent = 0;
+    uint64_t rejected = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+
+    while (last < frameCount && std::chrono::steady_clock::now() < deadline) {
+        const SharedRectFrame frame = AcquireSharedRectFrame(*ring, last);
+        if (frame.sequence == 0) continue;
+
+        const bool matches = CheckFrame(frame);
+        if (!ValidateSharedRectFrame(*ring, frame)) {
+            ++rejected;
+            continue;
+        }
+        if (!matches) return 3;
+
+        last = frame.sequence;
+        ++consistent;
+    }
+
+    std::cout << "reader: " << consistent << " consistent frames, " << rejected << " rejected while rewritten, last sequence " << last << std::endl;
+    return last == frameCount ? 0 : 4;
+}
+
+int main() {
+    const std::string name = "/discadelta_shm_sample_" + std::to_string(getpid());
+
+    auto ring = CreateSharedRectRing({.name = name, .slotCount = 3, .capacity = rectCount});
+    if (!ring) {
+        std::cout << "Could not create " << name << "\n";
+        return 1;
+    }
+
+    // The name is taken now: a second ring only replaces it when asked to
+    const bool refused = !CreateSharedRectRing({.name = name, .slotCount = 3, .capacity = rectCount});
+    std::cout << "second create without replaceExisting: " << (refused ? "refused" : "ACCEPTED") << "\n";
+
+    std::cout.flush();
+    const pid_t reader = fork();
+    if (reader < 0) return 1;
+    if (reader == 0) _exit(RunReader(name));
+
+    // Give the reader a moment to map the ring, then publish as fast as possible
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    RectExportBuffer staged;
+    staged.x.resize(rectCount);
+    staged.y.resize(rectCount);
+    staged.width.resize(rectCount);
+    staged.height.resize(rectCount);
+    staged.nodeId.resize(rectCount);
+    staged.depth.resize(rectCount);
+
+    for (uint64_t sequence = 1; sequence <= frameCount; ++sequence) {
+        FillFrame(staged, sequence);
+        PublishSharedRects(*ring, staged);
+    }
+
+    int status = 0;
+    waitpid(reader, &status, 0);
+    const bool readerPassed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+    std::cout << "writer: published " << frameCount << " frames | reader " << (readerPassed ? "passed" : "FAILED")
+              << " (status " << (WIFEXITED(status) ? WEXITSTATUS(status) : -1) << ")\n";
+
+    return refused && readerPassed ? 0 : 1;
+}
+#else
+int main() {
+    std::cout << "POSIX shared memory is not available on this platform; skipped\n";
+    return 0;
+}
+#endif
@@ -0,0 +1,131 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_simd;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Runs every dispatched SIMD kernel at each level the host supports, forced with
+// ForceSimdLevel, and compares the output bit for bit with the scalar kernel.
+//
+// The inputs mix ordinary layout values with the edge cases the kernels have to
+// agree on: halves for rounding, signed zeros, values past the 16- and 32-bit
+// ranges and, where the scalar reference defines it, NaN. Array lengths are not
+// multiples of any vector width, so the tails are covered too.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t count = 1003;
+
+const char* GetSimdLevelName(const SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::SSE41: return "sse4.1";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+// Deterministic values cycling through ordinary and edge-case inputs
+std::vector<float> MakeValues(const uint32_t seed, const bool withNaN) {
+    constexpr std::array<float, 12> edges = {
+        0.0f, -0.0f, 0.5f, -0.5f, 1.5f, -2.5f, 0x1.fffffep-2f, 8388609.0f,
+        40000.0f, -40000.0f, 70000.0f, 3.0e9f};
+
+    std::vector<float> values(count);
+    uint32_t state = seed;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        if (i % 5 == 0) values[i] = edges[(state >> 8) % edges.size()];
+        else values[i] = static_cast<float>(static_cast<int32_t>(state >> 12) - (1 << 19)) / 7.0f;
+    }
+    if (withNaN) values[count / 2] = std::numeric_limits<float>::quiet_NaN();
+    return values;
+}
+
+template<typename T>
+bool SameBits(const std::vector<T>& a, const std::vector<T>& b) noexcept {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+int main() {
+    RectExportBuffer staged;
+    staged.x = MakeValues(1, false);
+    staged.y = MakeValues(2, false);
+    staged.width = MakeValues(3, false);
+    staged.height = MakeValues(4, false);
+    staged.depth.resize(count);
+    staged.nodeId.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        staged.depth[i] = static_cast<uint16_t>(i % 7);
+        staged.nodeId[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    const std::vector<float> values = MakeValues(5, true);
+    const std::vector<float> to = MakeValues(6, true);
+    std::vector<float> lower = MakeValues(7, true);
+    std::vector<float> upper = MakeValues(8, true);
+    for (size_t i = 0; i < count; ++i) {
+        if (lower[i] > upper[i]) std::swap(lower[i], upper[i]);
+    }
+
+    // Scalar references
+    std::vector<RectInstance> instancesRef(count);
+    std::vector<std::array<int32_t, 4>> rectsRef(count);
+    std::vector<float> lerpRef(count);
+    std::vector<float> clampRef(count);
+    std::vector<float> roundRef(count);
+    QuantizeRectInstancesScalar(staged, 0, std::span(instancesRef));
+    TruncateRectsScalar(staged, 0, std::span(rectsRef));
+    LerpFloatsScalar(values, to, 0.3f, 0, lerpRef);
+    ScaleClampFloatsScalar(values, 1.25f, lower, upper, 0, clampRef);
+    RoundFloatsScalar(values, 0, roundRef);
+
+    const SimdLevel detected = DetectSimdLevel();
+    std::cout << "Detected SIMD level: " << GetSimdLevelName(detected) << "\n";
+
+    bool passed = true;
+    for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected) break;
+        ForceSimdLevel(level);
+
+        std::vector<RectInstance> instances(count);
+        std::vector<std::array<int32_t, 4>> rects(count);
+        std::vector<float> lerp(count);
+        std::vector<float> clamp(count);
+        std::vector<float> rounded(count);
+        QuantizeRectInstances(staged, std::span(instances));
+        TruncateRects(staged, std::span(rects));
+        LerpFloats(values, to, 0.3f, lerp);
+        ScaleClampFloats(values, 1.25f, lower, upper, clamp);
+        RoundFloats(values, rounded);
+
+        const bool quantizeMatches = SameBits(instances, instancesRef);
+        const bool truncateMatches = SameBits(rects, rectsRef);
+        const bool lerpMatches = SameBits(lerp, lerpRef);
+        const bool clampMatches = SameBits(clamp, clampRef);
+        const bool roundMatches = SameBits(rounded, roundRef);
+
+        std::cout << "  " << GetSimdLevelName(GetSimdLevel())
+                  << " | quantize: " << (quantizeMatches ? "ok" : "MISMATCH")
+                  << " | truncate: " << (truncateMatches ? "ok" : "MISMATCH")
+                  << " | lerp: " << (lerpMatches ? "ok" : "MISMATCH")
+                  << " | scale clamp: " << (clampMatches ? "ok" : "MISMATCH")
+                  << " | round: " << (roundMatches ? "ok" : "MISMATCH") << "\n";
+
+        passed = passed && quantizeMatches && truncateMatches && lerpMatches && clampMatches && roundMatches;
+    }
+
+    ForceSimdLevel(detected);
+
+    std::cout << (passed ? "Every level matches the scalar kernels\n" : "SIMD kernels MISMATCH\n");
+    return passed ? 0 : 1;
+}
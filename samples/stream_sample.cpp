@@ -0,0 +1,130 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_flat;
+import ufox_discadelta_stream;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Out-of-core two-pass solve of a segment list stored on disk, checked against
+// the in-memory flat cascade.
+//
+// Without min/max clamps both solvers distribute the same proportional shares, so
+// every distance and offset must agree. With clamps the stream solver resolves a
+// water level from bucketed thresholds; the sample reports how far its total
+// drifts from the input distance.
+// ─────────────────────────────────────────────────────────────────────────────
+std::vector<SegmentStreamRecord> MakeRecords(const size_t count, const bool clamped) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> baseDistribution(10.0f, 90.0f);
+    std::uniform_real_distribution<float> flexDistribution(0.1f, 1.0f);
+
+    std::vector<SegmentStreamRecord> records(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float base = baseDistribution(random);
+        records[i] = SegmentStreamRecord{
+            .base = base,
+            .flexCompress = flexDistribution(random),
+            .flexExpand = flexDistribution(random),
+            .min = clamped && i % 3 == 0 ? base * 0.8f : 0.0f,
+            .max = clamped && i % 4 == 0 ? base * 1.2f : std::numeric_limits<float>::max()};
+    }
+    return records;
+}
+
+bool WriteRecords(const std::filesystem::path& path, const std::vector<SegmentStreamRecord>& records) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SegmentStreamRecord)));
+    return static_cast<bool>(output);
+}
+
+std::vector<SegmentStreamResult> ReadResults(const std::filesystem::path& path, const size_t count) {
+    std::vector<SegmentStreamResult> results(count);
+    std::ifstream input(path, std::ios::binary);
+    input.read(reinterpret_cast<char*>(results.data()), static_cast<std::streamsize>(count * sizeof(SegmentStreamResult)));
+    if (static_cast<size_t>(input.gcount()) != count * sizeof(SegmentStreamResult)) results.clear();
+    return results;
+}
+
+int main() {
+    constexpr size_t count = 10000;
+    constexpr size_t chunkRecords = 1024;
+    constexpr float tolerance = 1e-3f;
+
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto inputPath = directory / "discadelta_stream_sample.bin";
+    const auto outputPath = directory / "discadelta_stream_sample_out.bin";
+
+    bool passed = true;
+
+    for (const bool clamped : {false, true}) {
+        const auto records = MakeRecords(count, clamped);
+        if (!WriteRecords(inputPath, records)) {
+            std::cout << "Could not write " << inputPath << "\n";
+            return 1;
+        }
+
+        // The same segments as flat configs, placed in file order
+        std::vector<LinearSegmentCreateInfo> configs(count);
+        for (size_t i = 0; i < count; ++i) {
+            configs[i] = LinearSegmentCreateInfo{
+                .name = std::to_string(i), .base = records[i].base,
+                .flexCompress = records[i].flexCompress, .flexExpand = records[i].flexExpand,
+                .min = records[i].min, .max = records[i].max, .order = i};
+        }
+
+        FlatPreComputeMetrics metrics;
+        PreComputeFlatMetrics(configs, metrics);
+        std::vector<LinearSegment> flat(count);
+
+        for (const float scale : {0.6f, 1.4f}) {
+            const float distance = metrics.accumulatedBase * scale;
+
+            const auto solution = SolveSegmentStream(inputPath, outputPath, distance, chunkRecords);
+            const auto streamed = solution ? ReadResults(outputPath, count) : std::vector<SegmentStreamResult>{};
+            if (streamed.size() != count) {
+                std::cout << "Stream solve failed\n";
+                return 1;
+            }
+
+            SolveFlatSegments(metrics, distance, false, flat);
+
+            double total = 0.0;
+            float maxDistanceError = 0.0f;
+            double maxOffsetError = 0.0;
+            for (size_t i = 0; i < count; ++i) {
+                total += streamed[i].distance;
+                maxDistanceError = std::max(maxDistanceError, std::abs(streamed[i].distance - flat[i].distance) / std::max(1.0f, flat[i].distance));
+                maxOffsetError = std::max(maxOffsetError, std::abs(streamed[i].offset - flat[i].offset) / std::max(1.0, streamed[i].offset));
+            }
+            const double totalDrift = std::abs(total - solution->inputDistance) / solution->inputDistance;
+
+            std::cout << std::scientific << std::setprecision(2)
+                      << "=== Stream Solve (" << (clamped ? "clamped" : "no clamp") << ", "
+                      << (solution->compressing ? "compress" : "expand") << ") ===\n"
+                      << "max distance error vs flat: " << maxDistanceError
+                      << " | max offset error vs flat: " << maxOffsetError
+                      << " | total drift: " << totalDrift << "\n";
+
+            // Unclamped, both solvers must agree; clamped, the total must still add up
+            if (!clamped && (maxDistanceError > tolerance || maxOffsetError > tolerance)) passed = false;
+            if (totalDrift > tolerance) passed = false;
+        }
+    }
+
+    std::filesystem::remove(inputPath);
+    std::filesystem::remove(outputPath);
+
+    std::cout << (passed ? "Stream solve matches\n" : "Stream solve MISMATCH\n");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include <array>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Constant-time ancestry queries through a subtree index, across edits.
+//
+// Every pair of contexts is checked with IsWithinSubtree against a walk up the
+// parent chain, and every GetSubtreeRange against the same walk. Then the tree
+// is edited with Link, Unlink, Attach, Detach and Graft in turn. After each
+// edit the old index must be reported stale and answer no query; once rebuilt,
+// it must agree with the parent walk again.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr size_t groupCount = 4;
+constexpr size_t itemsPerGroup = 3;
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+LinearSegmentContextHandler MakeLinear(const std::string& name) {
+    return CreateSegmentContext<LinearSegmentContext, LinearSegmentCreateInfo>({
+            .name = name, .base = 10.0f, .flexCompress = 1.0f, .flexExpand = 1.0f, .max = unbounded});
+}
+
+bool IsAncestorOrSelf(const LinearSegmentContext& subtreeRoot, const LinearSegmentContext* ctx) {
+    for (; ctx != nullptr; ctx = ctx->parent) {
+        if (ctx == &subtreeRoot) return true;
+    }
+    return false;
+}
+
+// Counts the queries that disagree with the parent walk, over the contexts of the tree
+size_t CountMismatches(const SegmentSubtreeIndex<LinearSegmentContext>& index, const std::vector<LinearSegmentContext*>& inTree) {
+    size_t mismatches = 0;
+    for (const LinearSegmentContext* subtreeRoot : inTree) {
+        for (const LinearSegmentContext* ctx : inTree) {
+            if (IsWithinSubtree(index, *ctx, *subtreeRoot) != IsAncestorOrSelf(*subtreeRoot, ctx)) ++mismatches;
+        }
+
+        const auto range = GetSubtreeRange(index, *subtreeRoot);
+        if (range.size() != subtreeRoot->branchCount || range.front() != subtreeRoot) ++mismatches;
+        for (const LinearSegmentContext* ctx : range) {
+            if (!IsAncestorOrSelf(*subtreeRoot, ctx)) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// Counts the queries a stale index still answers, over the contexts it was built for
+size_t CountStaleAnswers(const SegmentSubtreeIndex<LinearSegmentContext>& index, const std::vector<LinearSegmentContext*>& indexed) {
+    size_t answers = IsSubtreeIndexCurrent(index) ? 1 : 0;
+    for (const LinearSegmentContext* subtreeRoot : indexed) {
+        if (IsIndexed(index, *subtreeRoot) || !GetSubtreeRange(index, *subtreeRoot).empty()) ++answers;
+        for (const LinearSegmentContext* ctx : indexed) {
+            if (IsWithinSubtree(index, *ctx, *subtreeRoot)) ++answers;
+        }
+    }
+    return answers;
+}
+
+std::vector<LinearSegmentContext*> CollectTree(LinearSegmentContext& root) {
+    std::vector<LinearSegmentContext*> contexts{&root};
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        for (LinearSegmentContext* child : contexts[i]->children) contexts.push_back(child);
+    }
+    return contexts;
+}
+
+int main() {
+    std::vector<LinearSegmentContextHandler> nodes;
+    nodes.push_back(MakeLinear("Root"));
+    LinearSegmentContext& root = *nodes.front();
+
+    std::vector<LinearSegmentContext*> groups;
+    std::vector<LinearSegmentContext*> items;
+    for (size_t group = 0; group < groupCount; ++group) {
+        nodes.push_back(MakeLinear("Group" + std::to_string(group)));
+        groups.push_back(nodes.back().get());
+        Link(root, *groups.back());
+
+        for (size_t item = 0; item < itemsPerGroup; ++item) {
+            nodes.push_back(MakeLinear(groups.back()->config.name + "Item" + std::to_string(item)));
+            items.push_back(nodes.back().get());
+            Link(*groups.back(), *items.back());
+
+            for (size_t leaf = 0; leaf < item; ++leaf) {
+                nodes.push_back(MakeLinear(items.back()->config.name + "Leaf" + std::to_string(leaf)));
+                Link(*items.back(), *nodes.back());
+            }
+        }
+    }
+
+    std::array<LinearSegmentContextHandler, 2> grafted{MakeLinear("GraftA"), MakeLinear("GraftB")};
+    nodes.push_back(MakeLinear("GraftALeaf"));
+    Link(*grafted[0], *nodes.back());
+
+    SegmentSubtreeIndex<LinearSegmentContext> index;
+    std::vector<LinearSegmentContext*> indexed = CollectTree(root);
+    size_t built = BuildSubtreeIndex(index, root);
+    size_t mismatches = CountMismatches(index, indexed);
+    std::cout << "Built | contexts: " << built << " | mismatches against a parent walk: " << mismatches << "\n";
+    bool passed = built == indexed.size() && mismatches == 0;
+
+    const std::array<LinearSegmentContext*, 2> subtrees{grafted[0].get(), grafted[1].get()};
+    const std::vector<std::pair<const char*, std::function<void()>>> edits{
+            {"Unlink", [&] { Unlink(*items[2]); }},
+            {"Link  ", [&] { Link(*items[10], *items[2]); }},
+            {"Detach", [&] { Detach(*groups[1]); }},
+            {"Attach", [&] { Attach(*groups[3], *groups[1]); }},
+            {"Graft ", [&] { Graft(*items[4], std::span<LinearSegmentContext* const>(subtrees)); }},
+    };
+
+    for (const auto& [label, edit] : edits) {
+        edit();
+
+        const size_t staleAnswers = CountStaleAnswers(index, indexed);
+        indexed = CollectTree(root);
+        built = BuildSubtreeIndex(index, root);
+        mismatches = CountMismatches(index, indexed);
+        std::cout << label << " | stale answers: " << staleAnswers << " | rebuilt contexts: " << built
+                  << " | mismatches against a parent walk: " << mismatches << "\n";
+        passed = passed && staleAnswers == 0 && built == indexed.size() && mismatches == 0;
+    }
+
+    std::cout << (passed ? "Subtree index tracks every edit" : "Subtree index MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_transition;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Solve-free rect transition between two solved layouts of one tree.
+//
+// The ends of the transition must reproduce the two solved states exactly,
+// including progress values outside [0, 1], the midpoint must lie halfway,
+// and ApplyRectTransition must write each state back into `content`.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+struct RectState {
+    float x, y, width, height;
+};
+
+std::vector<RectState> Capture(const std::vector<RectSegmentContext*>& nodes) {
+    std::vector<RectState> states;
+    for (const RectSegmentContext* ctx : nodes) states.push_back({ctx->content.x, ctx->content.y, ctx->content.width, ctx->content.height});
+    return states;
+}
+
+size_t CountMismatches(const RectExportBuffer& buffer, const std::vector<RectState>& expected) {
+    size_t mismatches = buffer.x.size() == expected.size() ? 0 : 1;
+    for (size_t i = 0; i < std::min(buffer.x.size(), expected.size()); ++i) {
+        if (buffer.x[i] != expected[i].x || buffer.y[i] != expected[i].y
+            || buffer.width[i] != expected[i].width || buffer.height[i] != expected[i].height) ++mismatches;
+    }
+    return mismatches;
+}
+
+size_t CountMismatches(const std::vector<RectSegmentContext*>& nodes, const std::vector<RectState>& expected) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const RectSegment& content = nodes[i]->content;
+        if (content.x != expected[i].x || content.y != expected[i].y
+            || content.width != expected[i].width || content.height != expected[i].height) ++mismatches;
+    }
+    return mismatches;
+}
+
+int main() {
+    std::vector<RectSegmentContextHandler> owned;
+    owned.push_back(CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = "Root", .widthMax = unbounded, .heightMax = unbounded,
+            .direction = FlexDirection::Row, .flexCompress = 1.0f, .flexExpand = 1.0f}));
+
+    for (size_t panel = 0; panel < 4; ++panel) {
+        auto panelCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                .name = "Panel" + std::to_string(panel), .width = 90.0f + static_cast<float>(panel) * 17.0f, .widthMax = unbounded,
+                .heightMax = unbounded, .direction = FlexDirection::Column, .flexCompress = 1.0f, .flexExpand = 0.5f + static_cast<float>(panel) * 0.25f, .order = panel});
+        for (size_t row = 0; row < 3; ++row) {
+            auto rowCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                    .name = panelCtx->config.name + "Row" + std::to_string(row), .width = 40.0f, .widthMax = unbounded,
+                    .height = 21.0f + static_cast<float>(row) * 9.0f, .heightMax = unbounded,
+                    .flexCompress = 1.0f, .flexExpand = 1.0f, .order = row});
+            Link(*panelCtx, *rowCtx);
+            owned.push_back(std::move(rowCtx));
+        }
+        Link(*owned.front(), *panelCtx);
+        owned.push_back(std::move(panelCtx));
+    }
+
+    RectSegmentContext& root = *owned.front();
+    UpdateSegments(root, 733.0f, 411.0f, false);
+
+    RectTransition transition;
+    const size_t count = BeginRectTransition(transition, root);
+    const std::vector<RectState> start = Capture(transition.nodes);
+
+    // The end state comes from a different size and a changed configuration
+    owned[4]->config.width = 150.0f;
+    UpdateContextMetrics(*owned[4]);
+    UpdateSegments(root, 1097.0f, 523.0f, false);
+    EndRectTransition(transition);
+    const std::vector<RectState> end = Capture(transition.nodes);
+
+    size_t depthMismatches = 0;
+    size_t index = 0;
+    for (const auto& [ctx, depth] : TraversePlacementOrder(root)) {
+        if (index >= count || transition.nodes[index] != ctx || transition.end.depth[index] != depth) ++depthMismatches;
+        ++index;
+    }
+    size_t moved = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (start[i].x != end[i].x || start[i].width != end[i].width || start[i].height != end[i].height) ++moved;
+    }
+    std::cout << "Animated rects: " << count << " | moved: " << moved << " | depth mismatches: " << depthMismatches << "\n";
+    bool passed = count == root.branchCount && moved * 2 > count && depthMismatches == 0;
+
+    RectExportBuffer frame;
+    for (const auto& [t, expected, label] : {std::tuple{0.0f, &start, "t = 0"}, std::tuple{-0.5f, &start, "t = -0.5"},
+                                             std::tuple{1.0f, &end, "t = 1"}, std::tuple{1.5f, &end, "t = 1.5"}}) {
+        InterpolateRectTransition(transition, t, frame);
+        const size_t mismatches = CountMismatches(frame, *expected);
+        std::cout << "Interpolate " << label << " | mismatches: " << mismatches << "\n";
+        passed = passed && mismatches == 0;
+    }
+
+    InterpolateRectTransition(transition, 0.5f, frame);
+    size_t midpointMismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const float expected = (start[i].width + end[i].width) * 0.5f;
+        if (std::abs(frame.width[i] - expected) > 1e-3f * std::max(1.0f, expected)) ++midpointMismatches;
+    }
+    std::cout << "Interpolate t = 0.5 | widths off the midpoint: " << midpointMismatches << "\n";
+    passed = passed && midpointMismatches == 0;
+
+    RectExportBuffer staging;
+    ApplyRectTransition(transition, 0.0f, staging);
+    const size_t startApplied = CountMismatches(transition.nodes, start);
+    ApplyRectTransition(transition, 1.0f, staging);
+    const size_t endApplied = CountMismatches(transition.nodes, end);
+    std::cout << "Apply | start mismatches: " << startApplied << " | end mismatches: " << endApplied << "\n";
+    passed = passed && startApplied == 0 && endApplied == 0;
+
+    std::cout << (passed ? "Transition reproduces both solved states" : "Transition MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
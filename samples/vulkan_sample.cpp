@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_export;
+
+using namespace ufox::geometry::discadelta;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Batched Vulkan scissor and viewport export, checked against the per-node
+// MakeVKRect2D and MakeVKViewport on a tree solved without rounding.
+// The node-set overloads keep one output per input, with an empty rect or
+// viewport where the set holds a null entry.
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float unbounded = std::numeric_limits<float>::max();
+
+bool SameRect(const vk::Rect2D& a, const vk::Rect2D& b) noexcept {
+    return a.offset.x == b.offset.x && a.offset.y == b.offset.y && a.extent.width == b.extent.width && a.extent.height == b.extent.height;
+}
+
+bool SameViewport(const vk::Viewport& a, const vk::Viewport& b) noexcept {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height && a.minDepth == b.minDepth && a.maxDepth == b.maxDepth;
+}
+
+int main() {
+    std::vector<RectSegmentContextHandler> nodes;
+    nodes.push_back(CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+            .name = "Root", .widthMax = unbounded, .heightMax = unbounded,
+            .direction = FlexDirection::Row, .flexCompress = 1.0f, .flexExpand = 1.0f}));
+
+    for (size_t panel = 0; panel < 5; ++panel) {
+        auto panelCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                .name = "Panel" + std::to_string(panel), .width = 37.0f + static_cast<float>(panel) * 13.0f, .widthMax = unbounded,
+                .heightMax = unbounded, .direction = FlexDirection::Column, .flexCompress = 1.0f, .flexExpand = 1.0f, .order = panel});
+        for (size_t cell = 0; cell < 3; ++cell) {
+            auto cellCtx = CreateSegmentContext<RectSegmentContext, RectSegmentCreateInfo>({
+                    .name = panelCtx->config.name + "Cell" + std::to_string(cell), .width = unbounded, .widthMax = unbounded,
+                    .height = 11.0f + static_cast<float>(cell) * 7.0f, .heightMax = unbounded,
+                    .flexCompress = 1.0f, .flexExpand = 1.0f, .order = cell});
+            Link(*panelCtx, *cellCtx);
+            nodes.push_back(std::move(cellCtx));
+        }
+        Link(*nodes.front(), *panelCtx);
+        nodes.push_back(std::move(panelCtx));
+    }
+
+    RectSegmentContext& root = *nodes.front();
+    UpdateSegments(root, 643.0f, 217.0f, false);
+
+    std::vector<const RectSegmentContext*> placed;
+    for (const auto& node : TraversePlacementOrder(root)) placed.push_back(node.context);
+
+    RectExportBuffer staging;
+    std::vector<vk::Rect2D> rects(placed.size());
+    std::vector<vk::Viewport> viewports(placed.size());
+
+    // Whole subtree
+    size_t rectCount = MakeVKRect2Ds(root, staging, std::span(rects));
+    size_t viewportCount = MakeVKViewports(root, std::span(viewports));
+    size_t mismatches = rectCount == placed.size() && viewportCount == placed.size() ? 0 : 1;
+    for (size_t i = 0; i < std::min(rectCount, placed.size()); ++i) {
+        if (!SameRect(rects[i], MakeVKRect2D(*placed[i])) || !SameViewport(viewports[i], MakeVKViewport(*placed[i]))) ++mismatches;
+    }
+    std::cout << "Subtree  | rects: " << rectCount << " | viewports: " << viewportCount << " | mismatches: " << mismatches << "\n";
+    bool passed = mismatches == 0;
+
+    // Changed-node set with a gap
+    std::vector<const RectSegmentContext*> changed{placed[3], nullptr, placed[7], placed[1]};
+    rectCount = MakeVKRect2Ds(std::span<const RectSegmentContext* const>(changed), staging, std::span(rects));
+    viewportCount = MakeVKViewports(std::span<const RectSegmentContext* const>(changed), std::span(viewports), 0.25f, 0.75f);
+    mismatches = rectCount == changed.size() && viewportCount == changed.size() ? 0 : 1;
+    for (size_t i = 0; i < changed.size(); ++i) {
+        const vk::Rect2D expectedRect = changed[i] != nullptr ? MakeVKRect2D(*changed[i]) : vk::Rect2D{};
+        const vk::Viewport expectedViewport = changed[i] != nullptr ? MakeVKViewport(*changed[i], 0.25f, 0.75f) : vk::Viewport{0.0f, 0.0f, 0.0f, 0.0f, 0.25f, 0.75f};
+        if (!SameRect(rects[i], expectedRect) || !SameViewport(viewports[i], expectedViewport)) ++mismatches;
+    }
+    std::cout << "Node set | rects: " << rectCount << " | viewports: " << viewportCount << " | mismatches: " << mismatches << "\n";
+    passed = passed && mismatches == 0;
+
+    std::cout << (passed ? "Batched Vulkan export matches MakeVKRect2D" : "Batched Vulkan export MISMATCH") << std::endl;
+    return passed ? 0 : 1;
+}
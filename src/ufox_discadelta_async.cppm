@@ -0,0 +1,193 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module ufox_discadelta_async;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+
+export namespace ufox::geometry::discadelta {
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * A self-contained copy of a segment tree, solved for one layout request.
+     *
+     * Nodes are stored in the pre-order of the source tree, so `nodes[i]` is the
+     * i-th context visited by `TraversePreOrder` on the source root when the snapshot
+     * was taken. The first node is the root.
+     */
+    struct SegmentLayoutSnapshot {
+        uint64_t requestId{0};
+        SegmentLayoutRequest request{};
+        std::vector<ContextT> nodes;
+
+        [[nodiscard]] ContextT& Root() noexcept { return nodes.front(); }
+        [[nodiscard]] const ContextT& Root() const noexcept { return nodes.front(); }
+    };
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Deep-copies a subtree into a snapshot that can be solved on another thread.
+     *
+     * Every context is copied with its pre-computed metrics, and the parent and child
+     * links are rewired to the copies, so solving the snapshot never touches the source
+     * tree. The copied root is detached from any parent.
+     *
+     * @param root The root of the subtree to copy.
+     * @return The owned copy, in pre-order.
+     */
+    [[nodiscard]] std::unique_ptr<SegmentLayoutSnapshot<ContextT>> MakeLayoutSnapshot(const ContextT& root) {
+        auto snapshot = std::make_unique<SegmentLayoutSnapshot<ContextT>>();
+
+        size_t count = 0;
+        for ([[maybe_unused]] const auto& node : TraversePreOrder(root)) ++count;
+        snapshot->nodes.reserve(count);
+
+        std::unordered_map<const ContextT*, ContextT*> copies;
+        copies.reserve(count);
+
+        for (const auto& node : TraversePreOrder(root)) {
+            copies.emplace(node.context, &snapshot->nodes.emplace_back(*node.context));
+        }
+
+        for (ContextT& copy : snapshot->nodes) {
+            copy.parent = &copy == &snapshot->Root() ? nullptr : copies.at(copy.parent);
+            for (auto& child : copy.children) child = copies.at(child);
+        }
+
+        return snapshot;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Runs a segment layout on a background thread, keeping only the latest request.
+     *
+     * `Request` snapshots the tree on the calling thread, so the live tree can keep
+     * changing as soon as it returns. A new request cooperatively cancels the solve in
+     * flight between two nodes, through the stop token threaded into `Sizing`, and a
+     * cancelled solve is never published. Each returned future resolves with the first
+     * result completed at or after its request, which is the latest one that made it.
+     */
+    class AsyncLayoutService {
+    public:
+        using Snapshot = SegmentLayoutSnapshot<ContextT>;
+        using Result = std::shared_ptr<const Snapshot>;
+
+        AsyncLayoutService() : worker([this](const std::stop_token& stopToken) { Run(stopToken); }) {}
+
+        AsyncLayoutService(const AsyncLayoutService&) = delete;
+        AsyncLayoutService& operator=(const AsyncLayoutService&) = delete;
+
+        ~AsyncLayoutService() {
+            {
+                std::scoped_lock lock(mutex);
+                solveStop.request_stop();
+            }
+            worker.request_stop();
+        }
+
+        /**
+         * Snapshots a tree and schedules it to be solved, superseding any pending or running request.
+         *
+         * @param root The root of the tree to solve; only read during this call.
+         * @param request The sizes to solve for; `crossInput` is ignored by linear trees.
+         * @return A future resolved with the latest result that covers this request.
+         */
+        [[nodiscard]] std::future<Result> Request(const ContextT& root, const SegmentLayoutRequest& request) {
+            auto snapshot = MakeLayoutSnapshot(root);
+            snapshot->request = request;
+
+            std::promise<Result> promise;
+            auto future = promise.get_future();
+
+            {
+                std::scoped_lock lock(mutex);
+                snapshot->requestId = ++lastRequestId;
+                waiting.emplace_back(snapshot->requestId, std::move(promise));
+                pending = std::move(snapshot);
+                solveStop.request_stop();
+            }
+            wake.notify_one();
+
+            return future;
+        }
+
+        /**
+         * Returns the latest published result without waiting.
+         *
+         * @return The latest completed snapshot, or null if no solve has completed yet.
+         */
+        [[nodiscard]] Result Latest() const {
+            std::scoped_lock lock(mutex);
+            return latest;
+        }
+
+    private:
+        mutable std::mutex mutex;
+        std::condition_variable_any wake;
+        std::unique_ptr<Snapshot> pending;
+        std::stop_source solveStop;
+        std::vector<std::pair<uint64_t, std::promise<Result>>> waiting;
+        Result latest;
+        uint64_t lastRequestId{0};
+        std::jthread worker;
+
+        void Run(const std::stop_token& stopToken) {
+            while (true) {
+                std::unique_ptr<Snapshot> job;
+                std::stop_token solveToken;
+                {
+                    std::unique_lock lock(mutex);
+                    if (!wake.wait(lock, stopToken, [this] { return pending != nullptr; })) return;
+
+                    job = std::move(pending);
+                    solveStop = std::stop_source{};
+                    solveToken = solveStop.get_token();
+                }
+
+                ContextT& root = job->Root();
+                const SegmentLayoutRequest& request = job->request;
+                if constexpr (std::same_as<ContextT, LinearSegmentContext>) {
+                    Sizing(root, request.mainInput, 0.0f, request.round, solveToken);
+                }
+                else {
+                    Sizing(root, request.mainInput, request.crossInput, 0.0f, 0.0f, request.round, solveToken);
+                }
+
+                if (solveToken.stop_requested()) continue;
+                Placing(root);
+
+                std::scoped_lock lock(mutex);
+                latest = Result{std::move(job)};
+
+                std::erase_if(waiting, [this](auto& entry) {
+                    if (entry.first > latest->requestId) return false;
+                    entry.second.set_value(latest);
+                    return true;
+                });
+            }
+        }
+    };
+
+    using LinearAsyncLayoutService = AsyncLayoutService<LinearSegmentContext>;
+    using RectAsyncLayoutService = AsyncLayoutService<RectSegmentContext>;
+
+}
@@ -4,14 +4,20 @@
 module;
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
 #include <ranges>
 #include <format>
 #include <iomanip>
+#include <limits>
 #include <numeric>
+#include <span>
+#include <stop_token>
 #ifdef HAS_VULKAN
 #include <vulkan/vulkan_raii.hpp>
 #endif
@@ -22,8 +28,71 @@ import ufox_discadelta_lib;
 
 export namespace ufox::geometry::discadelta {
 
-    void Sizing(LinearSegmentContext& ctx, const float& value, const float& delta, const bool& round);
-    void Sizing(RectSegmentContext& ctx, const float& width, const float& height, const float& widthDelta, const float& heightDelta, const bool& round);
+    template<typename TargetT, typename ContextT>
+    concept SegmentResultTarget = requires(const TargetT& target, ContextT& ctx) {
+        { target.Result(ctx) } -> std::same_as<decltype((ctx.content))>;
+        { target.Descend(ctx) } -> std::convertible_to<bool>;
+    };
+
+    /**
+     * Writes the results of a solve into each context's own `content`.
+     *
+     * This is the default target of the sizing passes.
+     */
+    struct ContextSegmentResults {
+        template<typename ContextT>
+        [[nodiscard]] constexpr auto& Result(ContextT& ctx) const noexcept { return ctx.content; }
+
+        template<typename ContextT>
+        [[nodiscard]] constexpr bool Descend(const ContextT&) const noexcept { return true; }
+    };
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Writes into `content` like `ContextSegmentResults`, but stops below one context.
+     *
+     * The origin and its children are sized; the children reached by the cascade are
+     * collected into `deferred` instead of being descended into, so the caller can
+     * solve their subtrees separately, for instance on other threads.
+     */
+    struct DeferredSegmentResults {
+        const ContextT* origin{nullptr};
+        std::vector<ContextT*>* deferred{nullptr};
+
+        [[nodiscard]] constexpr auto& Result(ContextT& ctx) const noexcept { return ctx.content; }
+
+        [[nodiscard]] bool Descend(ContextT& ctx) const {
+            if (&ctx == origin) return true;
+            deferred->push_back(&ctx);
+            return false;
+        }
+    };
+
+    template<typename SegmentT>
+    requires std::same_as<SegmentT, LinearSegment> || std::same_as<SegmentT, RectSegment>
+    /**
+     * Writes the results of a solve into a caller-owned buffer, indexed by `resultIndex`.
+     *
+     * The contexts are only read, so several solves of the same pre-computed tree,
+     * each with its own buffer, can run concurrently.
+     */
+    struct BufferSegmentResults {
+        std::span<SegmentT> results;
+
+        template<typename ContextT>
+        [[nodiscard]] constexpr SegmentT& Result(const ContextT& ctx) const noexcept { return results[ctx.resultIndex]; }
+
+        template<typename ContextT>
+        [[nodiscard]] constexpr bool Descend(const ContextT&) const noexcept { return true; }
+    };
+
+    template<typename TargetT = ContextSegmentResults>
+    requires SegmentResultTarget<TargetT, LinearSegmentContext>
+    void Sizing(LinearSegmentContext& ctx, const float& value, const float& delta, const bool& round, const std::stop_token& stopToken = {}, const TargetT& target = {});
+    template<typename TargetT = ContextSegmentResults>
+    requires SegmentResultTarget<TargetT, RectSegmentContext>
+    void Sizing(RectSegmentContext& ctx, const float& width, const float& height, const float& widthDelta, const float& heightDelta, const bool& round, const std::stop_token& stopToken = {}, const TargetT& target = {});
 
     /**
      * Selects the greater of two distances.
@@ -111,7 +180,7 @@ export namespace ufox::geometry::discadelta {
         std::vector<size_t> indices(ctx.children.size());
         std::iota(indices.begin(), indices.end(), size_t{0});
 
-        std::ranges::sort(indices,[ctx](const size_t a, const size_t b) noexcept {return ctx.children[a]->order < ctx.children[b]->order;});
+        std::ranges::sort(indices,[&ctx](const size_t a, const size_t b) noexcept {return ctx.children[a]->order < ctx.children[b]->order;});
 
         return indices;
     }
@@ -174,7 +243,8 @@ export namespace ufox::geometry::discadelta {
      * This method recalculates and updates several accumulated metrics, including
      * base, minimum value, expand ratio, and compress solidify, based on the context's children.
      * It also updates the children indices map with the corresponding names and positions
-     * of the children. The method ensures proper handling of empty children by exiting early.
+     * of the children, refreshes each child's `siblingIndex` and invalidates the cached
+     * placement order. The method ensures proper handling of empty children by exiting early.
      *
      * @param ctx The LinearSegmentContext holding the metrics and children to update.
      */
@@ -184,6 +254,7 @@ export namespace ufox::geometry::discadelta {
         ctx.accumulatedExpandRatio        = 0.0f;
         ctx.accumulatedCompressSolidify   = 0.0f;
         ctx.childrenIndies.clear();
+        ctx.placementOrder.clear();
         if (ctx.children.empty()) return;
 
         ctx.childrenIndies.reserve(ctx.children.size());
@@ -191,6 +262,7 @@ export namespace ufox::geometry::discadelta {
         for (size_t i = 0; i < ctx.children.size(); ++i) {
             const auto& child = ctx.children[i];
             ctx.childrenIndies[child->config.name] = i;
+            child->siblingIndex = i;
             ctx.accumulatedBase += child->validatedBase;
             ctx.accumulatedMin += ChooseGreaterDistance(child->validatedMin, child->compressSolidify);
             ctx.accumulatedCompressSolidify += child->compressSolidify;
@@ -205,6 +277,7 @@ export namespace ufox::geometry::discadelta {
      * minimum dimensions, expansion ratios, and compress-solidify values, for a given
      * context object. It iterates through the child segments of the given context and
      * updates these metrics based on the sizes and configurations of the child segments.
+     * Each child's `siblingIndex` is refreshed and the cached placement order is invalidated.
      *
      * @param ctx The rectangle segment context whose accumulated metrics are updated.
      */
@@ -216,6 +289,7 @@ export namespace ufox::geometry::discadelta {
         ctx.accumulatedExpandRatio = 0.0f;
         ctx.accumulatedCompressSolidify = 0.0f;
         ctx.childrenIndies.clear();
+        ctx.placementOrder.clear();
         if (ctx.children.empty()) return;
 
         ctx.childrenIndies.reserve(ctx.children.size());
@@ -223,6 +297,7 @@ export namespace ufox::geometry::discadelta {
         for (size_t i = 0; i < ctx.children.size(); ++i) {
             const auto& child = ctx.children[i];
             ctx.childrenIndies[child->config.name] = i;
+            child->siblingIndex = i;
 
 
             float compressSolidify{0.0f};
@@ -251,6 +326,95 @@ export namespace ufox::geometry::discadelta {
         }
     }
 
+    /**
+     * Returns the process-wide thresholds used to pick a solve strategy per node.
+     *
+     * @return The thresholds currently in use.
+     */
+    [[nodiscard]] inline SegmentStrategyThresholds& GetSegmentStrategyThresholds() noexcept {
+        static SegmentStrategyThresholds thresholds{};
+        return thresholds;
+    }
+
+    /**
+     * Replaces the process-wide strategy thresholds, typically with calibrated ones at startup.
+     *
+     * Pre-computes read the thresholds without synchronization, so they must not be
+     * replaced while a pre-compute runs. Contexts keep their strategy until they are
+     * pre-computed again.
+     *
+     * @param thresholds The thresholds to use from now on.
+     */
+    inline void SetSegmentStrategyThresholds(const SegmentStrategyThresholds& thresholds) noexcept {
+        GetSegmentStrategyThresholds() = thresholds;
+    }
+
+    /**
+     * Picks the solve strategy of a node from its pre-computed features.
+     *
+     * Large subtrees descend in parallel and every other node runs the cascade on the
+     * calling thread. How the cascade itself runs is decided per direction while the
+     * priority lists are built: see `UpdatePriorityLists`.
+     *
+     * @param features The features recorded by the pre-compute.
+     * @param thresholds The thresholds separating the strategies.
+     * @return The strategy of the node.
+     */
+    [[nodiscard]] constexpr SegmentSolveStrategy SelectSolveStrategy(const SegmentNodeFeatures& features, const SegmentStrategyThresholds& thresholds) noexcept {
+        if (features.fanout > 1 && features.branchCount >= thresholds.parallelBranchCount) return SegmentSolveStrategy::ParallelDescent;
+        return SegmentSolveStrategy::Cascade;
+    }
+
+    /**
+     * Sorts cascade priorities by room, ties keeping their index order.
+     *
+     * The radix path is a stable four-pass LSD sort on the bit pattern of the room,
+     * which orders non-negative floats like their values, so both paths produce the
+     * same order; the radix one is linear in the number of children.
+     *
+     * @param priorities The (room, child index) pairs, in storage order.
+     * @param descending Whether the largest room comes first.
+     * @param radix Whether to use the radix sort instead of the comparison sort.
+     */
+    void SortCascadePriorities(std::vector<std::pair<float, size_t>>& priorities, const bool descending, const bool radix) {
+        if (!radix) {
+            std::ranges::sort(priorities, [descending](const auto& a, const auto& b) {
+                return (descending ? a.first > b.first : a.first < b.first) || (a.first == b.first && a.second < b.second);
+            });
+            return;
+        }
+
+        const auto key = [descending](const float room) noexcept {
+            const auto bits = std::bit_cast<uint32_t>(room);
+            return descending ? ~bits : bits;
+        };
+
+        std::vector<std::pair<float, size_t>> scratch(priorities.size());
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            std::array<size_t, 257> offsets{};
+            for (const auto& priority : priorities) ++offsets[((key(priority.first) >> shift) & 0xFFu) + 1];
+            for (size_t i = 1; i < offsets.size(); ++i) offsets[i] += offsets[i - 1];
+            for (const auto& priority : priorities) scratch[offsets[(key(priority.first) >> shift) & 0xFFu]++] = priority;
+            priorities.swap(scratch);
+        }
+    }
+
+    /**
+     * Returns the compress solidify, capacity and validated minimum a rect child offers along the parent's main axis.
+     *
+     * Both the compression cascade and the unconstrained check read a child through
+     * this, so the fast path is only taken when the cascade could not clamp.
+     *
+     * @param child The child context.
+     * @param isRow True if the parent lays its children out in a row.
+     * @return A tuple of the solidify, the capacity and the validated minimum.
+     */
+    [[nodiscard]] constexpr std::tuple<const float&, const float&, const float&>
+    GetCompressClampMetrics(const RectSegmentContext& child, const bool isRow) noexcept {
+        if (isRow) return {child.widthCompressSolidify, child.widthCompressCapacity, child.validatedWidthMin};
+        return {child.heightCompressSolidify, child.heightCompressCapacity, child.validatedHeightMin};
+    }
+
     template<typename ContextT>
     requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
     /**
@@ -259,30 +423,68 @@ export namespace ufox::geometry::discadelta {
      * This method evaluates the priority of compressing and expanding each child element
      * in the context based on available space. It populates the compression and expansion
      * cascade priority lists in order of importance, ensuring that priorities are sorted
-     * appropriately for subsequent usage. The method is designed to handle both linear
-     * segment contexts and contexts configured with flex directions.
+     * appropriately for subsequent usage; children with equal room keep their storage
+     * order. The method is designed to handle both linear segment contexts and contexts
+     * configured with flex directions.
+     *
+     * A direction in which no child can hit its clamp is flagged unconstrained instead:
+     * compression when every child's minimum lies within its solidified part, expansion
+     * when every child's maximum is unbounded. Its list is left empty and the cascade
+     * walks the children in storage order, since the visiting order cannot change who
+     * absorbs a clamped remainder when nothing clamps.
+     *
+     * The node's features and solve strategy are recorded along the way; lists of at
+     * least `radixFanout` children are ordered with the radix sort.
      *
      * @param ctx The context object containing child elements and priority lists.
      *            The context must include configuration details and state-dependent
      *            properties such as children, compressCascadePriorities, and expandCascadePriorities.
      */
-    constexpr void UpdatePriorityLists(ContextT& ctx) noexcept
+    void UpdatePriorityLists(ContextT& ctx) noexcept
     {
+        const SegmentStrategyThresholds& thresholds = GetSegmentStrategyThresholds();
+
         ctx.compressCascadePriorities.clear();
         ctx.expandCascadePriorities.clear();
+        ctx.compressUnconstrained = true;
+        ctx.expandUnconstrained = true;
+        ctx.features = {.fanout = ctx.children.size(), .branchCount = ctx.branchCount};
+        ctx.strategy = SelectSolveStrategy(ctx.features, thresholds);
 
-        if (ctx.children.empty()) {
-            return;
+        for (const auto& child : ctx.children) {
+            bool compressFree{true};
+            bool expandFree{true};
+
+            if constexpr (std::same_as<ContextT, LinearSegmentContext>) {
+                compressFree = child->validatedMin <= child->compressSolidify;
+                expandFree = child->validatedMax >= std::numeric_limits<float>::max();
+            }
+            else {
+                const bool isRow = ctx.config.direction == FlexDirection::Row;
+                const auto [solidify, capacity, validatedMin] = GetCompressClampMetrics(*child, isRow);
+                compressFree = validatedMin <= solidify;
+                expandFree = (isRow ? child->validatedWidthMax : child->validatedHeightMax) >= std::numeric_limits<float>::max();
+            }
+
+            ctx.compressUnconstrained = ctx.compressUnconstrained && compressFree;
+            ctx.expandUnconstrained = ctx.expandUnconstrained && expandFree;
         }
 
-        ctx.compressCascadePriorities.reserve(ctx.children.size());
-        ctx.expandCascadePriorities.reserve(ctx.children.size());
+        if (ctx.compressUnconstrained && ctx.expandUnconstrained) {
+            return;
+        }
 
         std::vector<std::pair<float, size_t>> compressPriorities;
         std::vector<std::pair<float, size_t>> expandPriorities;
 
-        compressPriorities.reserve(ctx.children.size());
-        expandPriorities.reserve(ctx.children.size());
+        if (!ctx.compressUnconstrained) {
+            ctx.compressCascadePriorities.reserve(ctx.children.size());
+            compressPriorities.reserve(ctx.children.size());
+        }
+        if (!ctx.expandUnconstrained) {
+            ctx.expandCascadePriorities.reserve(ctx.children.size());
+            expandPriorities.reserve(ctx.children.size());
+        }
 
         for (size_t i = 0; i < ctx.children.size(); ++i){
             const auto& child = ctx.children[i];
@@ -302,27 +504,49 @@ export namespace ufox::geometry::discadelta {
                 expandRoom   = ChooseGreaterDistance(0.0f,child->validatedHeightMax - child->validatedHeightBase);
             }
 
-            compressPriorities.emplace_back(compressRoom, i);
-            expandPriorities.emplace_back(expandRoom,   i);
+            if (!ctx.compressUnconstrained) compressPriorities.emplace_back(compressRoom, i);
+            if (!ctx.expandUnconstrained) expandPriorities.emplace_back(expandRoom,   i);
         }
 
-        std::ranges::sort(compressPriorities, [](const auto& a, const auto& b) {
-            return a.first < b.first;
-        });
+        const bool radix = ctx.children.size() >= thresholds.radixFanout;
 
+        SortCascadePriorities(compressPriorities, false, radix);
         for (const auto &val: compressPriorities | std::views::values) {
             ctx.compressCascadePriorities.push_back(val);
         }
 
-        std::ranges::sort(expandPriorities, [](const auto& a, const auto& b) {
-            return a.first > b.first;
-        });
-
+        SortCascadePriorities(expandPriorities, true, radix);
         for (const auto &val: expandPriorities | std::views::values) {
             ctx.expandCascadePriorities.push_back(val);
         }
     }
 
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Returns the number of children a cascade visits.
+     *
+     * @param ctx The context whose children are cascaded.
+     * @param priorities The priority list of the cascade.
+     * @param unconstrained Whether the cascade walks the children in storage order.
+     * @return The number of cascade steps.
+     */
+    [[nodiscard]] constexpr size_t GetCascadeCount(const ContextT& ctx, const std::vector<size_t>& priorities, const bool unconstrained) noexcept {
+        return unconstrained ? ctx.children.size() : priorities.size();
+    }
+
+    /**
+     * Returns the child index visited at a given step of a cascade.
+     *
+     * @param priorities The priority list of the cascade.
+     * @param unconstrained Whether the cascade walks the children in storage order.
+     * @param step The cascade step.
+     * @return The child index, which is the step itself for an unconstrained cascade.
+     */
+    [[nodiscard]] constexpr size_t GetCascadeIndex(const std::vector<size_t>& priorities, const bool unconstrained, const size_t step) noexcept {
+        return unconstrained ? step : priorities[step];
+    }
+
     /**
      * Validates and adjusts context metrics for a linear segment.
      *
@@ -402,6 +626,41 @@ export namespace ufox::geometry::discadelta {
         if (ValidateContextParent(ctx)) UpdateContextMetrics(*ctx.parent);
     }
 
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Adds the size of a linked subtree to the branch count of a context and all its ancestors.
+     *
+     * Their structure generation is advanced too, which invalidates every subtree index
+     * built over one of them.
+     *
+     * @param ctx The new parent of the subtree.
+     * @param count The number of contexts in the subtree.
+     */
+    constexpr void AddBranchCount(ContextT* ctx, const size_t count) noexcept {
+        for (; ctx != nullptr; ctx = ctx->parent) {
+            ctx->branchCount += count;
+            ++ctx->structureGeneration;
+        }
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Removes the size of an unlinked subtree from the branch count of a context and all its ancestors.
+     *
+     * Like `AddBranchCount`, it advances their structure generation.
+     *
+     * @param ctx The former parent of the subtree.
+     * @param count The number of contexts in the subtree.
+     */
+    constexpr void RemoveBranchCount(ContextT* ctx, const size_t count) noexcept {
+        for (; ctx != nullptr; ctx = ctx->parent) {
+            ctx->branchCount = ctx->branchCount > count ? ctx->branchCount - count : 1;
+            ++ctx->structureGeneration;
+        }
+    }
+
     template<typename ContextT>
     requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
     /**
@@ -409,7 +668,7 @@ export namespace ufox::geometry::discadelta {
      *
      * This method removes the specified `child` context from its parent context's
      * list of children. The relationship between the parent and child is severed,
-     * and the parent's branch count is adjusted accordingly. If the parent still
+     * and the branch counts of the parent and its ancestors are adjusted accordingly. If the parent still
      * has remaining children after the operation, its metrics are updated.
      *
      * @param child The context to be unlinked from its parent.
@@ -426,7 +685,7 @@ export namespace ufox::geometry::discadelta {
         }
 
         parent.children.erase(it);
-        parent.branchCount = std::max(size_t{1}, parent.branchCount - child.branchCount);
+        RemoveBranchCount(&parent, child.branchCount);
         child.parent = nullptr;
 
         if (!parent.children.empty()) {
@@ -443,7 +702,8 @@ export namespace ufox::geometry::discadelta {
      * If the child is already linked to the specified parent or if the parent and
      * child are the same, the function exits without changes. If the child is linked
      * to a different parent, it is first unlinked from its current parent. After linking,
-     * the parent's branch count is updated and context metrics are recalculated.
+     * the branch counts of the parent and its ancestors are updated and context metrics
+     * are recalculated.
      *
      * @param parent The context that will become the parent.
      * @param child The context to be linked as a child.
@@ -455,8 +715,96 @@ export namespace ufox::geometry::discadelta {
 
         child.parent = &parent;
         parent.children.push_back(&child);
-        parent.branchCount += child.branchCount;
+        AddBranchCount(&parent, child.branchCount);
+
+        UpdateContextMetrics(parent);
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Detaches a child context from its parent without recomputing any metrics.
+     *
+     * This is the structural half of `Unlink`, for callers that batch several edits
+     * and recompute the affected contexts once afterwards. Until then, the metrics of
+     * the former parent and its ancestors are stale.
+     *
+     * @param child The context to be detached from its parent.
+     * @return The former parent, which needs its metrics recomputed, or null if the child had none.
+     */
+    ContextT* Detach(ContextT& child) noexcept {
+        ContextT* parent = child.parent;
+        if (parent == nullptr) return nullptr;
+
+        child.parent = nullptr;
+
+        const auto it = std::ranges::find(parent->children, &child);
+        if (it == parent->children.end()) return nullptr;
+
+        parent->children.erase(it);
+        RemoveBranchCount(parent, child.branchCount);
+
+        return parent;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Attaches a child context to a parent without recomputing any metrics.
+     *
+     * This is the structural half of `Link`: a child linked elsewhere is detached
+     * first, and neither its former nor its new parent is recomputed.
+     *
+     * @param parent The context that will become the parent.
+     * @param child The context to be attached as a child.
+     * @return The child's former parent, which needs its metrics recomputed, or null if it had none.
+     */
+    ContextT* Attach(ContextT& parent, ContextT& child) noexcept {
+        if (&child == &parent || child.parent == &parent) return nullptr;
+
+        ContextT* formerParent = Detach(child);
+
+        child.parent = &parent;
+        parent.children.push_back(&child);
+        AddBranchCount(&parent, child.branchCount);
 
+        return formerParent;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Links a batch of detached subtrees to a parent context in one operation.
+     *
+     * Each subtree is expected to be fully built and pre-computed on its own, which
+     * makes it safe to construct disjoint subtrees concurrently on worker threads as
+     * long as no two threads touch the same context. Grafting then attaches every
+     * subtree root and refreshes the parent's ancestor chain exactly once, instead of
+     * once per `Link`. Null entries, the parent itself and children already linked to
+     * the parent are skipped; subtrees linked elsewhere are unlinked first.
+     *
+     * Grafting mutates the parent's ancestor chain and must not run concurrently with
+     * any other operation on that tree.
+     *
+     * @param parent The context that will become the parent of every subtree.
+     * @param subtrees The subtree roots to attach, in the order they are appended.
+     */
+    void Graft(ContextT& parent, const std::span<ContextT* const> subtrees) noexcept {
+        parent.children.reserve(parent.children.size() + subtrees.size());
+
+        size_t graftedCount = 0;
+        for (ContextT* child : subtrees) {
+            if (child == nullptr || child == &parent || child->parent == &parent) continue;
+            if (child->parent != nullptr) Unlink(*child);
+
+            child->parent = &parent;
+            parent.children.push_back(child);
+            graftedCount += child->branchCount;
+        }
+
+        if (graftedCount == 0) return;
+
+        AddBranchCount(&parent, graftedCount);
         UpdateContextMetrics(parent);
     }
 
@@ -469,7 +817,8 @@ export namespace ufox::geometry::discadelta {
      * It clears all child relationships, unlinks the context from its parent,
      * and resets any internal structures before deallocating the memory.
      * The function ensures no ownership over children, so they are unlinked
-     * but not destroyed.
+     * but not destroyed. A context that other threads may still be reading
+     * should be retired with `RetireSegmentContext` instead.
      *
      * @param ptr A pointer to the segment context to be destroyed. A null pointer
      *            input is safely handled without any operation.
@@ -590,6 +939,119 @@ export namespace ufox::geometry::discadelta {
         return distance <= 0.0f || accumulateFactor <= 0.0f || factor <= 0.0f ? 0.0f : distance / accumulateFactor * factor;
     }
 
+    template<typename PolicyT>
+    concept DistributionPolicy = requires(const PolicyT& policy, const float value) {
+        { PolicyT::weighted } -> std::convertible_to<bool>;
+        { policy.Weight(value) } -> std::same_as<float>;
+        { policy.Share(value, value, value) } -> std::same_as<float>;
+    };
+
+    /**
+     * Distributes a remaining distance in proportion to each child's factor, using `Scaler`.
+     *
+     * This is the default behavior of the cascade: compression follows the compress
+     * capacity and expansion the expand ratio, as accumulated by the pre-compute pass.
+     */
+    struct ProportionalDistribution {
+        static constexpr bool weighted = false;
+
+        [[nodiscard]] constexpr float Weight(const float factor) const noexcept { return factor; }
+        [[nodiscard]] constexpr float Share(const float distance, const float accumulateFactor, const float factor) const noexcept {
+            return Scaler(distance, accumulateFactor, factor);
+        }
+    };
+
+    /**
+     * Splits a remaining distance equally between every child with a non-zero factor.
+     */
+    struct EqualDistribution {
+        static constexpr bool weighted = true;
+
+        [[nodiscard]] constexpr float Weight(const float factor) const noexcept { return factor > 0.0f ? 1.0f : 0.0f; }
+        [[nodiscard]] constexpr float Share(const float distance, const float accumulateWeight, const float weight) const noexcept {
+            return Scaler(distance, accumulateWeight, weight);
+        }
+    };
+
+    /**
+     * Distributes a remaining distance in proportion to each child's factor rounded to a whole weight.
+     *
+     * Factors below one half get no share, so `1.4` and `0.6` split a distance evenly.
+     */
+    struct IntegerWeightedDistribution {
+        static constexpr bool weighted = true;
+
+        [[nodiscard]] constexpr float Weight(const float factor) const noexcept { return std::floor(ChooseGreaterDistance(0.0f, factor) + 0.5f); }
+        [[nodiscard]] constexpr float Share(const float distance, const float accumulateWeight, const float weight) const noexcept {
+            return Scaler(distance, accumulateWeight, weight);
+        }
+    };
+
+    /**
+     * Distributes a remaining distance proportionally, snapping every share down to a multiple of a grid step.
+     *
+     * The part of a share lost to snapping stays in the cascade and is offered to
+     * the following children; what the last child cannot take is left unused.
+     */
+    struct SnapToGridDistribution {
+        static constexpr bool weighted = false;
+        float step{1.0f};
+
+        [[nodiscard]] constexpr float Weight(const float factor) const noexcept { return factor; }
+        [[nodiscard]] constexpr float Share(const float distance, const float accumulateFactor, const float factor) const noexcept {
+            const float share = Scaler(distance, accumulateFactor, factor);
+            return step > 0.0f ? std::floor(share / step) * step : share;
+        }
+    };
+
+    template<typename PolicyT, typename ContextT, typename FactorT>
+    requires DistributionPolicy<PolicyT>
+    /**
+     * Sums the policy weights of a context's children for a weighted distribution.
+     *
+     * @param policy The distribution policy.
+     * @param ctx The context whose children share the distance.
+     * @param factor Returns the compress or expand factor of a child.
+     * @return The total weight, or zero for policies that use the pre-computed factors directly.
+     */
+    [[nodiscard]] constexpr float AccumulateDistributionWeight(const PolicyT& policy, const ContextT& ctx, FactorT&& factor) noexcept {
+        float total = 0.0f;
+        if constexpr (PolicyT::weighted) {
+            for (const auto* child : ctx.children) {
+                if (child != nullptr) total += policy.Weight(factor(*child));
+            }
+        }
+        return total;
+    }
+
+    template<typename ConfigT, typename FuncT>
+    requires std::same_as<ConfigT, LinearSegmentCreateInfo> || std::same_as<ConfigT, RectSegmentCreateInfo>
+    /**
+     * Calls a function with the distribution policy selected by a container's configuration.
+     *
+     * The switch runs once per container; the function is instantiated per policy, so
+     * the selected policy is inlined into the container's cascade loop.
+     *
+     * @param config The configuration of the container whose children are distributed.
+     * @param func The function receiving the policy object.
+     */
+    constexpr void DispatchDistribution(const ConfigT& config, FuncT&& func) {
+        switch (config.distribution) {
+            case DistributionMode::Equal:
+                func(EqualDistribution{});
+                break;
+            case DistributionMode::IntegerWeighted:
+                func(IntegerWeightedDistribution{});
+                break;
+            case DistributionMode::SnapToGrid:
+                func(SnapToGridDistribution{config.gridStep});
+                break;
+            default:
+                func(ProportionalDistribution{});
+                break;
+        }
+    }
+
     /**
      * Constructs a tuple containing compression cascade metrics.
      *
@@ -813,6 +1275,8 @@ export namespace ufox::geometry::discadelta {
         return ChooseGreaterDistance(0.0f, lowestCrossDistance, crossMin);
     }
 
+    template<typename PolicyT = ProportionalDistribution, typename TargetT = ContextSegmentResults>
+    requires DistributionPolicy<PolicyT> && SegmentResultTarget<TargetT, LinearSegmentContext>
     /**
      * Executes a compressing operation for a given linear segment context.
      *
@@ -825,29 +1289,41 @@ export namespace ufox::geometry::discadelta {
      * @param ctx The linear segment context representing the configuration for the compression operation.
      * @param inputDistance The distance value used to initialize the compression calculations.
      * @param round A boolean flag indicating whether distances should be rounded during computation.
+     * @param stopToken Checked before every child; once a stop is requested the pass returns, leaving the remaining children unsized.
+     * @param policy The distribution computing each child's share, inlined into the loop.
+     * @param target Where the children's results are written.
      */
-    void Compressing(const LinearSegmentContext& ctx, const float& inputDistance, const bool& round) noexcept {
+    void Compressing(const LinearSegmentContext& ctx, const float& inputDistance, const bool& round, const std::stop_token& stopToken = {}, const PolicyT& policy = {}, const TargetT& target = {}) noexcept {
         auto [cascadeCompressDistance, cascadeBaseDistance, cascadeCompressSolidify] = MakeCompressCascadeMetrics(inputDistance, ctx, round);
+        float cascadeWeight = AccumulateDistributionWeight(policy, ctx, [](const LinearSegmentContext& child) noexcept { return child.compressCapacity; });
 
-        for (const auto index : ctx.compressCascadePriorities) {
+        const size_t cascadeCount = GetCascadeCount(ctx, ctx.compressCascadePriorities, ctx.compressUnconstrained);
+        for (size_t step = 0; step < cascadeCount; ++step) {
+            const size_t index = GetCascadeIndex(ctx.compressCascadePriorities, ctx.compressUnconstrained, step);
             auto* childCtx = GetChildSegmentContext<LinearSegmentContext>(ctx,index);
             if (childCtx == nullptr) continue;
+            if (stopToken.stop_requested()) return;
             auto [remainDist, remainCap, greaterBase] = MakeCompressSizeMetrics(cascadeCompressDistance, cascadeBaseDistance, cascadeCompressSolidify, *childCtx, round);
             const float& solidify = childCtx->compressSolidify;
             const float& capacity = childCtx->compressCapacity;
             const float& validatedMin = childCtx->validatedMin;
-            const float compressBaseDistance = Scaler(remainDist, remainCap, capacity) + solidify;
+            const float weight = policy.Weight(capacity);
+            const float share = PolicyT::weighted ? policy.Share(remainDist, cascadeWeight, weight) : policy.Share(remainDist, remainCap, capacity);
+            const float compressBaseDistance = share + solidify;
             const float clampedDist = ChooseGreaterDistance(compressBaseDistance, validatedMin);
             const float roundedDist = round? std::lroundf(clampedDist) : clampedDist;
 
-            Sizing(*childCtx, roundedDist, 0.0f, round);
+            Sizing(*childCtx, roundedDist, 0.0f, round, stopToken, target);
 
             cascadeCompressDistance -= roundedDist;
             cascadeCompressSolidify -= solidify;
             cascadeBaseDistance -= greaterBase;
+            cascadeWeight -= weight;
         }
     }
 
+    template<typename PolicyT = ProportionalDistribution, typename TargetT = ContextSegmentResults>
+    requires DistributionPolicy<PolicyT> && SegmentResultTarget<TargetT, RectSegmentContext>
     /**
      * Computes and applies compression metrics for child segments within a rectangular segment context.
      *
@@ -861,18 +1337,25 @@ export namespace ufox::geometry::discadelta {
      * @param crossInput The secondary input value used for cross-wise computations.
      * @param isRow A flag indicating whether the compression is performed row-wise (true) or column-wise (false).
      * @param round A flag indicating whether computed distances should be rounded to the nearest integer.
+     * @param stopToken Checked before every child; once a stop is requested the remaining children are left unsized.
+     * @param policy The distribution computing each child's share, inlined into the loop.
+     * @param target Where the children's results are written.
      */
-    void Compressing(const RectSegmentContext& ctx, const float& mainInput, const float& crossInput, const bool& isRow, const bool& round) noexcept {
+    void Compressing(const RectSegmentContext& ctx, const float& mainInput, const float& crossInput, const bool& isRow, const bool& round, const std::stop_token& stopToken = {}, const PolicyT& policy = {}, const TargetT& target = {}) noexcept {
         auto [cascadeCompressDistance, cascadeBaseDistance, cascadeCompressSolidify] = MakeCompressCascadeMetrics(mainInput, crossInput, ctx, isRow, round);
+        float cascadeWeight = AccumulateDistributionWeight(policy, ctx, [isRow](const RectSegmentContext& child) noexcept { return std::get<1>(GetCompressClampMetrics(child, isRow)); });
 
-        for (const auto index : ctx.compressCascadePriorities) {
+        const size_t cascadeCount = GetCascadeCount(ctx, ctx.compressCascadePriorities, ctx.compressUnconstrained);
+        for (size_t step = 0; step < cascadeCount; ++step) {
+            const size_t index = GetCascadeIndex(ctx.compressCascadePriorities, ctx.compressUnconstrained, step);
             auto* childCtx = GetChildSegmentContext(ctx,index);
             if (childCtx == nullptr) continue;
+            if (stopToken.stop_requested()) return;
             auto [remainDist, remainCap, validatedBase] = MakeCompressSizeMetrics(cascadeCompressDistance, cascadeBaseDistance, cascadeCompressSolidify, *childCtx, isRow, round);
-            const float& solidify = isRow ? ctx.widthCompressSolidify : ctx.heightCompressSolidify;
-            const float& capacity = isRow ? ctx.widthCompressCapacity : ctx.heightCompressCapacity;
-            const float& validatedMin = isRow ? ctx.validatedWidthMin : ctx.validatedHeightMin;
-            const float compressBaseDistance = Scaler(remainDist, remainCap, capacity) + solidify;
+            const auto [solidify, capacity, validatedMin] = GetCompressClampMetrics(*childCtx, isRow);
+            const float weight = policy.Weight(capacity);
+            const float share = PolicyT::weighted ? policy.Share(remainDist, cascadeWeight, weight) : policy.Share(remainDist, remainCap, capacity);
+            const float compressBaseDistance = share + solidify;
             const float clampedDist = ChooseGreaterDistance(compressBaseDistance, validatedMin);
             const float roundedDist = round? std::lroundf(clampedDist) : clampedDist;
 
@@ -881,14 +1364,17 @@ export namespace ufox::geometry::discadelta {
             const float& widthDist = isRow ? roundedDist : roundedOppositeBase;
             const float& heightDist = isRow ? roundedOppositeBase : roundedDist;
 
-            Sizing(*childCtx, widthDist, heightDist, 0.0f, 0.0f, round);
+            Sizing(*childCtx, widthDist, heightDist, 0.0f, 0.0f, round, stopToken, target);
 
             cascadeCompressDistance -= roundedDist;
             cascadeCompressSolidify -= solidify;
             cascadeBaseDistance -= validatedBase;
+            cascadeWeight -= weight;
         }
     }
 
+    template<typename PolicyT = ProportionalDistribution, typename TargetT = ContextSegmentResults>
+    requires DistributionPolicy<PolicyT> && SegmentResultTarget<TargetT, LinearSegmentContext>
     /**
      * Performs the expansion of linear segments within a hierarchical structure.
      *
@@ -896,34 +1382,45 @@ export namespace ufox::geometry::discadelta {
      * given input distance and contextual properties from the parent segment.
      * The expansion adjusts the sizes of child segments iteratively, considering
      * the maximum allowable delta and applying optional rounding to the values.
+     * When the input leaves no delta, every child is still sized, with a delta of zero.
      *
      * @param ctx The context of the parent linear segment that contains
      *            properties and priorities for cascading the expansion.
      * @param inputDistance The initial distance that drives the expansion process.
      * @param round A boolean flag indicating whether the expansion delta values
      *              should be rounded to the nearest integer.
+     * @param stopToken Stops the pass before the next child once a stop is requested.
+     * @param policy The distribution computing each child's share, inlined into the loop.
+     * @param target Where the children's results are written.
      */
-    void Expanding(const LinearSegmentContext& ctx, const float& inputDistance, const bool& round) {
+    void Expanding(const LinearSegmentContext& ctx, const float& inputDistance, const bool& round, const std::stop_token& stopToken = {}, const PolicyT& policy = {}, const TargetT& target = {}) {
         auto [processingExpansion,cascadeExpandDelta, cascadeExpandRatio] = MakeExpandCascadeMetrics(inputDistance, ctx, round);
-        if (!processingExpansion) return;
+        float cascadeWeight = AccumulateDistributionWeight(policy, ctx, [](const LinearSegmentContext& child) noexcept { return child.expandRatio; });
 
-        for (const auto index : ctx.expandCascadePriorities) {
+        const size_t cascadeCount = GetCascadeCount(ctx, ctx.expandCascadePriorities, ctx.expandUnconstrained);
+        for (size_t step = 0; step < cascadeCount; ++step) {
+            const size_t index = GetCascadeIndex(ctx.expandCascadePriorities, ctx.expandUnconstrained, step);
             auto* childCtx = GetChildSegmentContext(ctx,index);
             if (childCtx == nullptr) continue;
+            if (stopToken.stop_requested()) return;
 
             auto [validateBase, maxDelta] = MakeExpandSizeMetrics(*childCtx, round);
             const float& expandRatio = childCtx->expandRatio;
-            const float expandDelta = Scaler(cascadeExpandDelta, cascadeExpandRatio, expandRatio);
+            const float weight = policy.Weight(expandRatio);
+            const float expandDelta = PolicyT::weighted ? policy.Share(cascadeExpandDelta, cascadeWeight, weight) : policy.Share(cascadeExpandDelta, cascadeExpandRatio, expandRatio);
             const float clampedDelta = ChooseLowestDistance(expandDelta, maxDelta);
             const float roundedDelta = round? std::lroundf(clampedDelta) : clampedDelta;
 
-            Sizing(*childCtx, validateBase, roundedDelta, round);
+            Sizing(*childCtx, validateBase, roundedDelta, round, stopToken, target);
 
             cascadeExpandDelta -= roundedDelta;
             cascadeExpandRatio -= expandRatio;
+            cascadeWeight -= weight;
         }
     }
 
+    template<typename PolicyT = ProportionalDistribution, typename TargetT = ContextSegmentResults>
+    requires DistributionPolicy<PolicyT> && SegmentResultTarget<TargetT, RectSegmentContext>
     /**
      * Manages the expansion process for a rectangular segment context.
      *
@@ -931,7 +1428,8 @@ export namespace ufox::geometry::discadelta {
      * segment context, distributing delta adjustments across child segments
      * based on their priorities, expand ratios, and size metrics. The expansion
      * process considers whether the operation is row-oriented and optionally
-     * rounds the computed results.
+     * rounds the computed results. When the input leaves no delta, every child is
+     * still sized, with a delta of zero.
      *
      * @param ctx The context of the rectangular segment to be expanded, containing
      *            all relevant data including child segments and priority information.
@@ -940,19 +1438,25 @@ export namespace ufox::geometry::discadelta {
      * @param isRow Indicates whether the expansion is row-oriented (true for horizontal expansion,
      *              false for vertical expansion).
      * @param round Specifies whether computed floating-point values should be rounded to the nearest integer.
+     * @param stopToken Stops the pass before the next child once a stop is requested.
+     * @param policy The distribution computing each child's share, inlined into the loop.
+     * @param target Where the children's results are written.
      */
-    void Expanding(const RectSegmentContext& ctx, const float& mainInput, const float& crossInput, const bool& isRow, const bool& round) {
+    void Expanding(const RectSegmentContext& ctx, const float& mainInput, const float& crossInput, const bool& isRow, const bool& round, const std::stop_token& stopToken = {}, const PolicyT& policy = {}, const TargetT& target = {}) {
         auto [processingExpansion,cascadeExpandDelta, cascadeExpandRatio] = MakeExpandCascadeMetrics(mainInput, crossInput, ctx, isRow, round);
+        float cascadeWeight = AccumulateDistributionWeight(policy, ctx, [](const RectSegmentContext& child) noexcept { return child.expandRatio; });
 
-        if (!processingExpansion) return;
-
-        for (const auto index : ctx.expandCascadePriorities) {
+        const size_t cascadeCount = GetCascadeCount(ctx, ctx.expandCascadePriorities, ctx.expandUnconstrained);
+        for (size_t step = 0; step < cascadeCount; ++step) {
+            const size_t index = GetCascadeIndex(ctx.expandCascadePriorities, ctx.expandUnconstrained, step);
             auto* childCtx = GetChildSegmentContext(ctx,index);
             if (childCtx == nullptr) continue;
+            if (stopToken.stop_requested()) return;
 
             auto [validatedBase, maxDelta] = MakeExpandSizeMetrics(*childCtx, isRow, round);
             const float& expandRatio = childCtx->expandRatio;
-            const float expandDelta = Scaler(cascadeExpandDelta, cascadeExpandRatio, expandRatio);
+            const float weight = policy.Weight(expandRatio);
+            const float expandDelta = PolicyT::weighted ? policy.Share(cascadeExpandDelta, cascadeWeight, weight) : policy.Share(cascadeExpandDelta, cascadeExpandRatio, expandRatio);
             const float clampedDelta = ChooseLowestDistance(expandDelta, maxDelta);
             const float roundedDelta = round? std::lroundf(clampedDelta) : clampedDelta;
 
@@ -964,10 +1468,11 @@ export namespace ufox::geometry::discadelta {
             const float& widthDist = isRow ? validatedBase : roundedOppositeBase;
             const float& heightDist = isRow ? roundedOppositeBase : validatedBase;
 
-            Sizing(*childCtx, widthDist, heightDist, widthDelta, heightDelta , round);
+            Sizing(*childCtx, widthDist, heightDist, widthDelta, heightDelta , round, stopToken, target);
 
             cascadeExpandDelta -= roundedDelta;
             cascadeExpandRatio -= expandRatio;
+            cascadeWeight -= weight;
         }
     }
 
@@ -983,20 +1488,28 @@ export namespace ufox::geometry::discadelta {
      * @param value The input value used to compute the base distance.
      * @param delta The incremental change for the distance.
      * @param round A flag indicating whether rounding should be applied during processing.
+     * @param stopToken Forwarded to the compression or expansion pass, so the whole subtree can be cancelled between nodes.
+     * @param target Where the results of the segment and its subtree are written, and whether the subtree is descended into.
      */
-    void Sizing(LinearSegmentContext& ctx, const float& value, const float& delta, const bool& round) {
+    template<typename TargetT>
+    requires SegmentResultTarget<TargetT, LinearSegmentContext>
+    void Sizing(LinearSegmentContext& ctx, const float& value, const float& delta, const bool& round, const std::stop_token& stopToken, const TargetT& target) {
         const auto [validatedInputDistance, processingCompression] = MakeSizeMetrics(value, ctx, round);
 
-        ctx.content.base  = validatedInputDistance;
-        ctx.content.expandDelta = delta;
-        ctx.content.distance = validatedInputDistance + delta;
+        LinearSegment& content = target.Result(ctx);
+        content.base  = validatedInputDistance;
+        content.expandDelta = delta;
+        content.distance = validatedInputDistance + delta;
+        if (!target.Descend(ctx)) return;
 
-        if (processingCompression) {
-            Compressing(ctx, ctx.content.distance, round);
-        }
-        else {
-            Expanding(ctx, ctx.content.distance, round);
-        }
+        DispatchDistribution(ctx.config, [&](const auto& policy) {
+            if (processingCompression) {
+                Compressing(ctx, content.distance, round, stopToken, policy, target);
+            }
+            else {
+                Expanding(ctx, content.distance, round, stopToken, policy, target);
+            }
+        });
     }
 
     /**
@@ -1012,23 +1525,104 @@ export namespace ufox::geometry::discadelta {
      * @param widthDelta The additional width to expand or adjust the segment.
      * @param heightDelta The additional height to expand or adjust the segment.
      * @param round Indicates whether dimensions should be rounded during processing.
+     * @param stopToken Forwarded to the compression or expansion pass, so the whole subtree can be cancelled between nodes.
+     * @param target Where the results of the segment and its subtree are written, and whether the subtree is descended into.
      */
-    void Sizing(RectSegmentContext& ctx, const float& width, const float& height, const float& widthDelta, const float& heightDelta, const bool& round) {
+    template<typename TargetT>
+    requires SegmentResultTarget<TargetT, RectSegmentContext>
+    void Sizing(RectSegmentContext& ctx, const float& width, const float& height, const float& widthDelta, const float& heightDelta, const bool& round, const std::stop_token& stopToken, const TargetT& target) {
         const auto [validatedWidthInput, validatedHeightInput, isRow, processingCompression] = MakeSizeMetrics(width, height, ctx, round);
 
-        ctx.content.widthBase  = validatedWidthInput;
-        ctx.content.heightBase = validatedHeightInput;
-        ctx.content.widthExpandDelta = widthDelta;
-        ctx.content.heightExpandDelta = heightDelta;
-        ctx.content.width = validatedWidthInput + widthDelta;
-        ctx.content.height = validatedHeightInput + heightDelta;
+        RectSegment& content = target.Result(ctx);
+        content.widthBase  = validatedWidthInput;
+        content.heightBase = validatedHeightInput;
+        content.widthExpandDelta = widthDelta;
+        content.heightExpandDelta = heightDelta;
+        content.width = validatedWidthInput + widthDelta;
+        content.height = validatedHeightInput + heightDelta;
+        if (!target.Descend(ctx)) return;
+
+        DispatchDistribution(ctx.config, [&](const auto& policy) {
+            if (processingCompression) {
+                Compressing(ctx, content.width, content.height, isRow, round, stopToken, policy, target);
+            }
+            else {
+                Expanding(ctx, content.width, content.height, isRow, round, stopToken, policy, target);
+            }
+        });
+    }
 
-        if (processingCompression) {
-            Compressing(ctx, ctx.content.width, ctx.content.height, isRow, round);
-        }
-        else {
-            Expanding(ctx, ctx.content.width, ctx.content.height, isRow, round);
+    /**
+     * Checks whether a sized linear segment is too small to be worth placing in detail.
+     *
+     * @param segment The sized segment.
+     * @param threshold The level-of-detail threshold, in the same unit as distances.
+     * @return True if the segment's distance is below the threshold.
+     */
+    [[nodiscard]] constexpr bool IsBelowDetailThreshold(const LinearSegment& segment, const float threshold) noexcept {
+        return segment.distance < threshold;
+    }
+
+    /**
+     * Checks whether a sized rectangular segment is too small to be worth placing in detail.
+     *
+     * @param segment The sized segment.
+     * @param threshold The level-of-detail threshold, in the same unit as distances.
+     * @return True if the segment's width or height is below the threshold.
+     */
+    [[nodiscard]] constexpr bool IsBelowDetailThreshold(const RectSegment& segment, const float threshold) noexcept {
+        return segment.width < threshold || segment.height < threshold;
+    }
+
+    /**
+     * Checks whether a sized linear context is too small to be worth placing in detail.
+     *
+     * @param ctx The sized context.
+     * @param threshold The level-of-detail threshold, in the same unit as distances.
+     * @return True if the context's distance is below the threshold.
+     */
+    [[nodiscard]] constexpr bool IsBelowDetailThreshold(const LinearSegmentContext& ctx, const float threshold) noexcept {
+        return IsBelowDetailThreshold(ctx.content, threshold);
+    }
+
+    /**
+     * Checks whether a sized rectangular context is too small to be worth placing in detail.
+     *
+     * @param ctx The sized context.
+     * @param threshold The level-of-detail threshold, in the same unit as distances.
+     * @return True if the context's width or height is below the threshold.
+     */
+    [[nodiscard]] constexpr bool IsBelowDetailThreshold(const RectSegmentContext& ctx, const float threshold) noexcept {
+        return IsBelowDetailThreshold(ctx.content, threshold);
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Refreshes the cached placement order of a context's children.
+     *
+     * Children are ordered by their `order` property, ties keeping their storage order,
+     * and the result is stored in `placementOrder` so the buffer is reused between passes.
+     * Every child also records its own position in that order as `placementIndex`.
+     *
+     * @param ctx The context whose children's placement order is refreshed.
+     * @return The refreshed placement order, as indices into `ctx.children`.
+     */
+    constexpr const std::vector<size_t>& UpdatePlacementOrder(ContextT& ctx) noexcept {
+        ctx.placementOrder.resize(ctx.children.size());
+        std::iota(ctx.placementOrder.begin(), ctx.placementOrder.end(), size_t{0});
+
+        std::ranges::sort(ctx.placementOrder, [&ctx](const size_t a, const size_t b) noexcept {
+            const size_t orderA = ctx.children[a]->order;
+            const size_t orderB = ctx.children[b]->order;
+            return orderA < orderB || (orderA == orderB && a < b);
+        });
+
+        for (size_t i = 0; i < ctx.placementOrder.size(); ++i) {
+            ctx.children[ctx.placementOrder[i]]->placementIndex = i;
         }
+
+        return ctx.placementOrder;
     }
 
     /**
@@ -1039,25 +1633,27 @@ export namespace ufox::geometry::discadelta {
      * and propagates updated offsets to all child segments. If no children exist, the function terminates early.
      *
      * The function ensures that child segments are ordered and processed sequentially, using
-     * the ordering determined by `GetOrderedIndices`. For each child, it recursively applies
+     * the ordering cached by `UpdatePlacementOrder`. For each child, it recursively applies
      * the same offset adjustment, taking into account the distance between segments.
      *
      * @param ctx A reference to the primary `LinearSegmentContext` whose positional offsets
      *            (and its children's offsets) need to be updated.
      * @param parentOffset An optional starting offset for the current segment. Defaults to 0.0f
      *                     if not specified.
+     * @param lodThreshold Segments smaller than this are placed but not descended into, leaving
+     *                     their subtrees stale. Defaults to 0.0f, which places every segment.
      */
-    constexpr void Placing(LinearSegmentContext& ctx, const float& parentOffset = 0.0f) noexcept {
+    constexpr void Placing(LinearSegmentContext& ctx, const float& parentOffset = 0.0f, const float lodThreshold = 0.0f) noexcept {
         ctx.content.offset = parentOffset;
-        if (ctx.children.empty()) return;
+        if (ctx.children.empty() || IsBelowDetailThreshold(ctx, lodThreshold)) return;
 
-        const auto indices = GetOrderedIndices(ctx);
+        const auto& indices = UpdatePlacementOrder(ctx);
 
         float currentOffset = parentOffset;
         for (const size_t idx : indices) {
             auto* childCtx = GetChildSegmentContext(ctx,idx);
             if (childCtx == nullptr) continue;
-            Placing(*childCtx, currentOffset);
+            Placing(*childCtx, currentOffset, lodThreshold);
             currentOffset += childCtx->content.distance;
         }
     }
@@ -1074,15 +1670,17 @@ export namespace ufox::geometry::discadelta {
      *            children, and layout configuration.
      * @param relativeX The x-coordinate offset relative to the parent context. Defaults to 0.0f.
      * @param relativeY The y-coordinate offset relative to the parent context. Defaults to 0.0f.
+     * @param lodThreshold Segments narrower or shorter than this are placed but not descended into,
+     *                     leaving their subtrees stale. Defaults to 0.0f, which places every segment.
      */
-    constexpr void Placing(RectSegmentContext& ctx, const float relativeX = 0.0f, const float relativeY = 0.0f) noexcept
+    constexpr void Placing(RectSegmentContext& ctx, const float relativeX = 0.0f, const float relativeY = 0.0f, const float lodThreshold = 0.0f) noexcept
     {
         ctx.content.x = relativeX;
         ctx.content.y = relativeY;
 
-        if (ctx.children.empty()) return;
+        if (ctx.children.empty() || IsBelowDetailThreshold(ctx, lodThreshold)) return;
 
-        const auto orderedIndices = GetOrderedIndices(ctx);
+        const auto& orderedIndices = UpdatePlacementOrder(ctx);
         const bool isRow = ctx.config.direction == FlexDirection::Row;
         float currentMainOffset = 0.0f;
 
@@ -1093,7 +1691,7 @@ export namespace ufox::geometry::discadelta {
             const float childX = relativeX + (isRow ? currentMainOffset : 0.0f);
             const float childY = relativeY + (isRow ? 0.0f : currentMainOffset);
 
-            Placing(*child, childX, childY);
+            Placing(*child, childX, childY, lodThreshold);
 
             currentMainOffset += isRow ? child->content.width : child->content.height;
         }
@@ -1109,6 +1707,9 @@ export namespace ufox::geometry::discadelta {
      * linear segment context. It utilizes the input distance, a rounding flag,
      * and a fixed start value to perform necessary updates.
      *
+     * The whole tree is solved on the calling thread whatever the `strategy` of its
+     * nodes; `ParallelUpdateSegments` is the form that honours `ParallelDescent`.
+     *
      * @param rootCtx The linear segment context to update.
      * @param inputDistance The distance value used to determine segment adjustments.
      * @param round A boolean flag indicating whether rounding should be applied.
@@ -1124,6 +1725,8 @@ export namespace ufox::geometry::discadelta {
      * This method adjusts the sizing and placement parameters of the segments
      * within the given RectSegmentContext. The inputs specify the primary and
      * secondary dimensions, along with an option to apply rounding during the update.
+     * Like the linear form, it ignores the `strategy` of the nodes and solves on the
+     * calling thread; see `ParallelUpdateSegments`.
      *
      * @param rootCtx The context containing the root segment to be updated.
      * @param mainInput The primary input value influencing the update.
@@ -1135,6 +1738,277 @@ export namespace ufox::geometry::discadelta {
         Placing(rootCtx);
     }
 
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Prepares a pre-computed tree to be solved into caller-owned result buffers.
+     *
+     * Every context of the subtree receives its pre-order position as `resultIndex`,
+     * the root being zero, and its placement order is refreshed, so that the buffered
+     * solves afterwards only read the tree. Call it again whenever the structure or
+     * the `order` of a context changes.
+     *
+     * @param root The root of the tree.
+     * @return The number of contexts, which is the size every result buffer needs.
+     */
+    size_t IndexSegmentResults(ContextT& root) {
+        size_t count = 0;
+        std::vector<ContextT*> stack{&root};
+
+        while (!stack.empty()) {
+            ContextT* ctx = stack.back();
+            stack.pop_back();
+
+            ctx->resultIndex = count++;
+            UpdatePlacementOrder(*ctx);
+
+            for (auto child = ctx->children.rbegin(); child != ctx->children.rend(); ++child) {
+                if (*child != nullptr) stack.push_back(*child);
+            }
+        }
+
+        return count;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * The contexts of a tree laid out in pre-order, so every subtree is one contiguous range.
+     *
+     * `nodes[ctx.resultIndex]` is `&ctx`, and the subtree of `ctx` covers the
+     * `ctx.branchCount` entries from there. The index describes the tree as it was when
+     * built: it records the root's structure generation, and the queries reject it once
+     * a link, unlink, attach, detach or graft below the root has advanced it. Rebuild it
+     * after any such change.
+     */
+    struct SegmentSubtreeIndex {
+        std::vector<ContextT*> nodes;
+        const ContextT* root{nullptr};
+        uint64_t generation{0};
+    };
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Lays a tree out in pre-order from its branch counts.
+     *
+     * Each child is placed right after its preceding siblings' subtrees, so one forward
+     * sweep over the nodes assigns every `resultIndex` without a stack. The indices are
+     * the ones `IndexSegmentResults` assigns, so result buffers can be sliced by
+     * subtree too. Placement orders are left untouched.
+     *
+     * @param index The index to rebuild.
+     * @param root The root of the tree.
+     * @return The number of indexed contexts, or zero if the branch counts do not match the tree.
+     */
+    size_t BuildSubtreeIndex(SegmentSubtreeIndex<ContextT>& index, ContextT& root) {
+        auto& nodes = index.nodes;
+        index.root = &root;
+        index.generation = root.structureGeneration;
+        nodes.assign(root.branchCount, nullptr);
+        nodes[0] = &root;
+        root.resultIndex = 0;
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            ContextT* ctx = nodes[i];
+            size_t next = i + 1;
+
+            for (ContextT* child : ctx->children) {
+                if (child == nullptr) continue;
+                if (next + child->branchCount > i + ctx->branchCount) {
+                    nodes.clear();
+                    return 0;
+                }
+
+                child->resultIndex = next;
+                nodes[next] = child;
+                next += child->branchCount;
+            }
+
+            if (next != i + ctx->branchCount) {
+                nodes.clear();
+                return 0;
+            }
+        }
+
+        return nodes.size();
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Checks that the tree has not changed structure since an index was built.
+     *
+     * @param index The index to check.
+     * @return True if the index was built and its root's structure generation is unchanged.
+     */
+    [[nodiscard]] constexpr bool IsSubtreeIndexCurrent(const SegmentSubtreeIndex<ContextT>& index) noexcept {
+        return index.root != nullptr && !index.nodes.empty() && index.root->structureGeneration == index.generation;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Checks in constant time that a context still sits where an index placed it.
+     *
+     * @param index The index to check against.
+     * @param ctx The context to check.
+     * @return True if the index is current and holds the context at its `resultIndex`.
+     */
+    [[nodiscard]] constexpr bool IsIndexed(const SegmentSubtreeIndex<ContextT>& index, const ContextT& ctx) noexcept {
+        return IsSubtreeIndexCurrent(index) && ctx.resultIndex < index.nodes.size() && index.nodes[ctx.resultIndex] == &ctx;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Checks in constant time whether a context lies in the subtree of another one.
+     *
+     * A context is within its own subtree. The answer comes from the pre-order ranges of
+     * the index, so it is false whenever the index is stale or does not hold both contexts;
+     * rebuild the index and ask again in that case.
+     *
+     * @param index A current index of the tree holding both contexts.
+     * @param ctx The context to locate.
+     * @param subtreeRoot The root of the subtree.
+     * @return True if the index is current and `subtreeRoot` is `ctx` or one of its ancestors.
+     */
+    [[nodiscard]] constexpr bool IsWithinSubtree(const SegmentSubtreeIndex<ContextT>& index, const ContextT& ctx, const ContextT& subtreeRoot) noexcept {
+        if (!IsIndexed(index, ctx) || !IsIndexed(index, subtreeRoot)) return false;
+        return ctx.resultIndex - subtreeRoot.resultIndex < subtreeRoot.branchCount;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Returns the contexts of a subtree, in pre-order, as one contiguous range.
+     *
+     * The range can be handed to `RecomputeDirtyMetrics` to mark and recompute a whole
+     * subtree at once.
+     *
+     * @param index A current index of the tree.
+     * @param subtreeRoot The root of the subtree, first in the range.
+     * @return The contexts of the subtree, or an empty range if the root is not indexed.
+     */
+    [[nodiscard]] std::span<ContextT* const> GetSubtreeRange(const SegmentSubtreeIndex<ContextT>& index, const ContextT& subtreeRoot) noexcept {
+        if (!IsIndexed(index, subtreeRoot)) return {};
+        return std::span<ContextT* const>(index.nodes).subspan(subtreeRoot.resultIndex, subtreeRoot.branchCount);
+    }
+
+    template<typename SegmentT, typename ContextT>
+    requires (std::same_as<SegmentT, LinearSegment> && std::same_as<ContextT, LinearSegmentContext>) || (std::same_as<SegmentT, RectSegment> && std::same_as<ContextT, RectSegmentContext>)
+    /**
+     * Returns the results of a subtree from a buffer filled by the buffered solves.
+     *
+     * @param results A result buffer indexed by `resultIndex`.
+     * @param subtreeRoot The root of the subtree, first in the range.
+     * @return The results of the subtree, in pre-order.
+     */
+    [[nodiscard]] constexpr std::span<SegmentT> GetSubtreeResults(const std::span<SegmentT> results, const ContextT& subtreeRoot) noexcept {
+        if (subtreeRoot.resultIndex >= results.size()) return {};
+        return results.subspan(subtreeRoot.resultIndex, std::min(subtreeRoot.branchCount, results.size() - subtreeRoot.resultIndex));
+    }
+
+    /**
+     * Places the solved linear segments of a buffer, without writing to the contexts.
+     *
+     * This is `Placing` for results stored by `BufferSegmentResults`: it follows the
+     * placement order cached by `IndexSegmentResults` and only writes `offset`.
+     *
+     * @param ctx The context to place.
+     * @param results The buffer holding the solved segments, indexed by `resultIndex`.
+     * @param parentOffset The offset of the context.
+     * @param lodThreshold Segments smaller than this are placed but not descended into.
+     */
+    constexpr void PlaceSegmentResults(const LinearSegmentContext& ctx, const std::span<LinearSegment> results, const float parentOffset = 0.0f, const float lodThreshold = 0.0f) noexcept {
+        LinearSegment& content = results[ctx.resultIndex];
+        content.offset = parentOffset;
+        if (ctx.children.empty() || IsBelowDetailThreshold(content, lodThreshold)) return;
+
+        const bool ordered = ctx.placementOrder.size() == ctx.children.size();
+
+        float currentOffset = parentOffset;
+        for (size_t i = 0; i < ctx.children.size(); ++i) {
+            const auto* childCtx = GetChildSegmentContext(ctx, ordered ? ctx.placementOrder[i] : i);
+            if (childCtx == nullptr) continue;
+            PlaceSegmentResults(*childCtx, results, currentOffset, lodThreshold);
+            currentOffset += results[childCtx->resultIndex].distance;
+        }
+    }
+
+    /**
+     * Places the solved rectangular segments of a buffer, without writing to the contexts.
+     *
+     * This is `Placing` for results stored by `BufferSegmentResults`: it follows the
+     * placement order cached by `IndexSegmentResults` and only writes `x` and `y`.
+     *
+     * @param ctx The context to place.
+     * @param results The buffer holding the solved segments, indexed by `resultIndex`.
+     * @param relativeX The x-coordinate of the context.
+     * @param relativeY The y-coordinate of the context.
+     * @param lodThreshold Segments narrower or shorter than this are placed but not descended into.
+     */
+    constexpr void PlaceSegmentResults(const RectSegmentContext& ctx, const std::span<RectSegment> results, const float relativeX = 0.0f, const float relativeY = 0.0f, const float lodThreshold = 0.0f) noexcept {
+        RectSegment& content = results[ctx.resultIndex];
+        content.x = relativeX;
+        content.y = relativeY;
+        if (ctx.children.empty() || IsBelowDetailThreshold(content, lodThreshold)) return;
+
+        const bool ordered = ctx.placementOrder.size() == ctx.children.size();
+        const bool isRow = ctx.config.direction == FlexDirection::Row;
+        float currentMainOffset = 0.0f;
+
+        for (size_t i = 0; i < ctx.children.size(); ++i) {
+            const auto* child = GetChildSegmentContext(ctx, ordered ? ctx.placementOrder[i] : i);
+            if (child == nullptr) continue;
+
+            const float childX = relativeX + (isRow ? currentMainOffset : 0.0f);
+            const float childY = relativeY + (isRow ? 0.0f : currentMainOffset);
+
+            PlaceSegmentResults(*child, results, childX, childY, lodThreshold);
+
+            const RectSegment& childContent = results[child->resultIndex];
+            currentMainOffset += isRow ? childContent.width : childContent.height;
+        }
+    }
+
+    /**
+     * Solves a linear tree into a caller-owned buffer instead of the contexts.
+     *
+     * The tree is only read, so one tree prepared with `IndexSegmentResults` can be
+     * solved for several sizes at once from different threads, each with its own
+     * buffer, as long as nothing modifies the tree meanwhile.
+     *
+     * @param rootCtx The root of a tree prepared with `IndexSegmentResults`.
+     * @param inputDistance The distance of the root.
+     * @param round Whether distances are rounded to whole units.
+     * @param results The buffer receiving one segment per context, indexed by `resultIndex`.
+     * @param lodThreshold Segments smaller than this are placed but not descended into.
+     */
+    void SolveSegmentResults(LinearSegmentContext& rootCtx, const float inputDistance, const bool round, const std::span<LinearSegment> results, const float lodThreshold = 0.0f) {
+        Sizing(rootCtx, inputDistance, 0.0f, round, {}, BufferSegmentResults<LinearSegment>{results});
+        PlaceSegmentResults(rootCtx, results, 0.0f, lodThreshold);
+    }
+
+    /**
+     * Solves a rectangular tree into a caller-owned buffer instead of the contexts.
+     *
+     * The tree is only read, so one tree prepared with `IndexSegmentResults` can be
+     * solved for several sizes at once from different threads, each with its own
+     * buffer, as long as nothing modifies the tree meanwhile.
+     *
+     * @param rootCtx The root of a tree prepared with `IndexSegmentResults`.
+     * @param mainInput The main-axis size of the root.
+     * @param crossInput The cross-axis size of the root.
+     * @param round Whether distances are rounded to whole units.
+     * @param results The buffer receiving one segment per context, indexed by `resultIndex`.
+     * @param lodThreshold Segments narrower or shorter than this are placed but not descended into.
+     */
+    void SolveSegmentResults(RectSegmentContext& rootCtx, const float mainInput, const float crossInput, const bool round, const std::span<RectSegment> results, const float lodThreshold = 0.0f) {
+        Sizing(rootCtx, mainInput, crossInput, 0.0f, 0.0f, round, {}, BufferSegmentResults<RectSegment>{results});
+        PlaceSegmentResults(rootCtx, results, 0.0f, 0.0f, lodThreshold);
+    }
+
 #ifdef HAS_VULKAN
     /**
      * Converts a RectSegmentContext object to a Vulkan-compatible vk::Rect2D structure.
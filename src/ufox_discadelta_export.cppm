@@ -0,0 +1,374 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#ifdef HAS_VULKAN
+#include <vulkan/vulkan_raii.hpp>
+#endif
+
+export module ufox_discadelta_export;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_traversal;
+import ufox_discadelta_simd;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Clears a rect export buffer while keeping its capacity for the next frame.
+     *
+     * @param buffer The staging buffer to reset.
+     */
+    void ClearRectExportBuffer(RectExportBuffer& buffer) noexcept {
+        buffer.x.clear();
+        buffer.y.clear();
+        buffer.width.clear();
+        buffer.height.clear();
+        buffer.depth.clear();
+        buffer.nodeId.clear();
+    }
+
+    /**
+     * Appends the placed rect of one context to a rect export buffer.
+     *
+     * The node id is the context's pre-order `resultIndex`, assigned by
+     * `IndexSegmentResults` or `BuildSubtreeIndex`, so an instance maps back to
+     * `nodes[nodeId]` of a subtree index or to the same slot of a result buffer.
+     * It is truncated to 32 bits.
+     *
+     * @param buffer The staging buffer receiving the rect.
+     * @param ctx The context whose placed rect is appended.
+     * @param depth The depth of the context relative to the exported root.
+     */
+    void AppendRectExport(RectExportBuffer& buffer, const RectSegmentContext& ctx, const size_t depth) noexcept {
+        buffer.x.push_back(ctx.content.x);
+        buffer.y.push_back(ctx.content.y);
+        buffer.width.push_back(ctx.content.width);
+        buffer.height.push_back(ctx.content.height);
+        buffer.depth.push_back(static_cast<uint16_t>(std::min<size_t>(depth, std::numeric_limits<uint16_t>::max())));
+        buffer.nodeId.push_back(static_cast<uint32_t>(ctx.resultIndex));
+    }
+
+    /**
+     * Appends an empty rect standing in for a missing context, so later entries keep their positions.
+     *
+     * The rect is zero in every dimension and its node id is the largest `uint32_t`,
+     * which no indexed context uses.
+     *
+     * @param buffer The staging buffer receiving the rect.
+     */
+    void AppendEmptyRectExport(RectExportBuffer& buffer) noexcept {
+        buffer.x.push_back(0.0f);
+        buffer.y.push_back(0.0f);
+        buffer.width.push_back(0.0f);
+        buffer.height.push_back(0.0f);
+        buffer.depth.push_back(0);
+        buffer.nodeId.push_back(std::numeric_limits<uint32_t>::max());
+    }
+
+    /**
+     * Stages the placed rects of a subtree in placement order.
+     *
+     * The buffer is cleared first and then filled by a placement-order walk, so
+     * once it has grown to the size of the tree, staging allocates nothing.
+     *
+     * @param root The placed root of the subtree to stage.
+     * @param buffer The staging buffer receiving the rects.
+     * @param leavesOnly Whether only leaf contexts are staged.
+     * @return The number of staged rects.
+     */
+    size_t StageRectExport(const RectSegmentContext& root, RectExportBuffer& buffer, const bool leavesOnly) noexcept {
+        ClearRectExportBuffer(buffer);
+
+        if (leavesOnly) {
+            for (const auto& [ctx, depth] : TraversePlacedLeaves(root)) AppendRectExport(buffer, *ctx, depth);
+        }
+        else {
+            for (const auto& [ctx, depth] : TraversePlacementOrder(root)) AppendRectExport(buffer, *ctx, depth);
+        }
+
+        return buffer.x.size();
+    }
+
+    /**
+     * Stages the placed rects of an arbitrary set of contexts, such as the nodes changed this frame.
+     *
+     * Rects are staged in the order of the given span and carry a depth of zero.
+     * Null entries stage an empty rect, so entry `i` always belongs to `nodes[i]`.
+     *
+     * @param nodes The contexts to stage.
+     * @param buffer The staging buffer receiving the rects.
+     * @return The number of staged rects, which is the size of `nodes`.
+     */
+    size_t StageRectExport(const std::span<const RectSegmentContext* const> nodes, RectExportBuffer& buffer) noexcept {
+        ClearRectExportBuffer(buffer);
+
+        for (const RectSegmentContext* ctx : nodes) {
+            if (ctx != nullptr) AppendRectExport(buffer, *ctx, 0);
+            else AppendEmptyRectExport(buffer);
+        }
+
+        return buffer.x.size();
+    }
+
+    /**
+     * Stages the placed rects of a set of contexts together with their recorded depths.
+     *
+     * The depth of a context is taken from the same position of `depths`; contexts
+     * past its end carry a depth of zero. Null entries stage an empty rect.
+     *
+     * @param nodes The contexts to stage.
+     * @param depths The depth of every context relative to the root it was collected from.
+     * @param buffer The staging buffer receiving the rects.
+     * @return The number of staged rects, which is the size of `nodes`.
+     */
+    size_t StageRectExport(const std::span<const RectSegmentContext* const> nodes, const std::span<const size_t> depths, RectExportBuffer& buffer) noexcept {
+        ClearRectExportBuffer(buffer);
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i] != nullptr) AppendRectExport(buffer, *nodes[i], i < depths.size() ? depths[i] : 0);
+            else AppendEmptyRectExport(buffer);
+        }
+
+        return buffer.x.size();
+    }
+
+    /**
+     * Writes the placed rects of a subtree into a packed GPU instance buffer.
+     *
+     * Rects are staged in placement order and converted with the SIMD quantization
+     * kernel into 16-byte `RectInstance` records: positions as `int16_t`, sizes as
+     * `uint16_t`, plus the depth and node id. The target is typically a persistently
+     * mapped upload buffer; if it is too small, the leading rects that fit are written.
+     * Node ids are only meaningful once the tree has been indexed.
+     *
+     * @param root The placed root of the subtree to export.
+     * @param staging A reusable staging buffer, owned by the caller.
+     * @param target The instance buffer receiving the rects.
+     * @param leavesOnly Whether only leaf contexts are exported.
+     * @return The number of instances written.
+     */
+    size_t ExportRectInstances(const RectSegmentContext& root, RectExportBuffer& staging, const std::span<RectInstance> target, const bool leavesOnly = false) noexcept {
+        const size_t count = std::min(StageRectExport(root, staging, leavesOnly), target.size());
+        QuantizeRectInstances(staging, target.first(count));
+        return count;
+    }
+
+    /**
+     * Narrows a number of contexts to the 32-bit segment count of a LOD entry, saturating.
+     *
+     * @param count The number of contexts an entry stands for.
+     * @return The count, at most the largest `uint32_t`.
+     */
+    [[nodiscard]] constexpr uint32_t ClampSegmentCount(const size_t count) noexcept {
+        return static_cast<uint32_t>(std::min<size_t>(count, std::numeric_limits<uint32_t>::max()));
+    }
+
+    /**
+     * Appends a context and, level of detail permitting, its descendants to a LOD export buffer.
+     *
+     * Children are visited in placement order. Runs of consecutive children below the
+     * threshold are merged into one entry whose rect is the bounding box of the run,
+     * whose node id is the first child's and whose segment count is the number of
+     * contexts in the run's subtrees; their subtrees are not visited.
+     *
+     * @param buffer The LOD buffer receiving the entries.
+     * @param ctx The placed context to append; it counts one, or its whole subtree if that is pruned.
+     * @param depth The depth of the context relative to the exported root.
+     * @param threshold The size below which siblings are aggregated.
+     */
+    void AppendRectExportLOD(RectLodExportBuffer& buffer, const RectSegmentContext& ctx, const size_t depth, const float threshold) {
+        const bool pruned = IsBelowDetailThreshold(ctx, threshold);
+        AppendRectExport(buffer.rects, ctx, depth);
+        buffer.segmentCount.push_back(pruned ? ClampSegmentCount(ctx.branchCount) : 1);
+
+        if (ctx.children.empty() || pruned) return;
+
+        const bool placed = ctx.placementOrder.size() == ctx.children.size();
+        size_t runStart = 0;
+        size_t runCount = 0;
+        float runLeft = 0.0f, runTop = 0.0f, runRight = 0.0f, runBottom = 0.0f;
+
+        const auto closeRun = [&]() {
+            if (runCount == 0) return;
+            RectExportBuffer& rects = buffer.rects;
+            rects.x[runStart] = runLeft;
+            rects.y[runStart] = runTop;
+            rects.width[runStart] = runRight - runLeft;
+            rects.height[runStart] = runBottom - runTop;
+            buffer.segmentCount[runStart] = ClampSegmentCount(runCount);
+            runCount = 0;
+        };
+
+        for (size_t i = 0; i < ctx.children.size(); ++i) {
+            const RectSegmentContext* child = ctx.children[placed ? ctx.placementOrder[i] : i];
+            if (child == nullptr) continue;
+
+            if (!IsBelowDetailThreshold(*child, threshold)) {
+                closeRun();
+                AppendRectExportLOD(buffer, *child, depth + 1, threshold);
+                continue;
+            }
+
+            const RectSegment& content = child->content;
+            if (runCount == 0) {
+                runStart = buffer.rects.x.size();
+                AppendRectExport(buffer.rects, *child, depth + 1);
+                buffer.segmentCount.push_back(0);
+                runLeft = content.x;
+                runTop = content.y;
+                runRight = content.x + content.width;
+                runBottom = content.y + content.height;
+            }
+            else {
+                runLeft = std::min(runLeft, content.x);
+                runTop = std::min(runTop, content.y);
+                runRight = std::max(runRight, content.x + content.width);
+                runBottom = std::max(runBottom, content.y + content.height);
+            }
+            runCount += child->branchCount;
+        }
+
+        closeRun();
+    }
+
+    /**
+     * Stages the placed rects of a subtree with level-of-detail aggregation.
+     *
+     * Segments at least `threshold` wide and tall are staged one by one like
+     * `StageRectExport`; runs of smaller siblings become single aggregate spans and
+     * their subtrees are skipped, so the output grows with the screen area rather
+     * than with the number of segments. A tree placed with the same `lodThreshold`
+     * is exported consistently, since skipped subtrees are never read.
+     *
+     * @param root The placed root of the subtree to stage.
+     * @param buffer The LOD buffer receiving the rects and their segment counts.
+     * @param threshold The size below which siblings are aggregated, typically one pixel.
+     * @return The number of staged entries.
+     */
+    size_t StageRectExportLOD(const RectSegmentContext& root, RectLodExportBuffer& buffer, const float threshold) {
+        ClearRectExportBuffer(buffer.rects);
+        buffer.segmentCount.clear();
+
+        AppendRectExportLOD(buffer, root, 0, threshold);
+
+        return buffer.rects.x.size();
+    }
+
+    /**
+     * Writes the level-of-detail rects of a subtree into a packed GPU instance buffer.
+     *
+     * @param root The placed root of the subtree to export.
+     * @param staging A reusable LOD staging buffer, owned by the caller; it keeps the segment counts.
+     * @param target The instance buffer receiving the rects.
+     * @param threshold The size below which siblings are aggregated.
+     * @return The number of instances written.
+     */
+    size_t ExportRectInstancesLOD(const RectSegmentContext& root, RectLodExportBuffer& staging, const std::span<RectInstance> target, const float threshold) {
+        const size_t count = std::min(StageRectExportLOD(root, staging, threshold), target.size());
+        QuantizeRectInstances(staging.rects, target.first(count));
+        return count;
+    }
+
+#ifdef HAS_VULKAN
+    /**
+     * Converts the placed rects of a subtree into Vulkan scissor rects in one pass.
+     *
+     * This is the batched form of `MakeVKRect2D`: rects are staged in placement order
+     * and converted with the SIMD truncation kernel, producing the same values as
+     * calling `MakeVKRect2D` per node. If the target is too small, the leading rects
+     * that fit are written.
+     *
+     * @param root The placed root of the subtree to convert.
+     * @param staging A reusable staging buffer, owned by the caller.
+     * @param target The Vulkan rects receiving the result.
+     * @param leavesOnly Whether only leaf contexts are converted.
+     * @return The number of rects written.
+     */
+    size_t MakeVKRect2Ds(const RectSegmentContext& root, RectExportBuffer& staging, const std::span<vk::Rect2D> target, const bool leavesOnly = false) noexcept {
+        const size_t count = std::min(StageRectExport(root, staging, leavesOnly), target.size());
+        TruncateRects(staging, target.first(count));
+        return count;
+    }
+
+    /**
+     * Converts the placed rects of a set of contexts into Vulkan scissor rects in one pass.
+     *
+     * @param nodes The contexts to convert, such as the nodes changed this frame; null entries get an empty rect.
+     * @param staging A reusable staging buffer, owned by the caller.
+     * @param target The Vulkan rects receiving the result, in the order of `nodes`.
+     * @return The number of rects written.
+     */
+    size_t MakeVKRect2Ds(const std::span<const RectSegmentContext* const> nodes, RectExportBuffer& staging, const std::span<vk::Rect2D> target) noexcept {
+        const size_t count = std::min(StageRectExport(nodes, staging), target.size());
+        TruncateRects(staging, target.first(count));
+        return count;
+    }
+
+    /**
+     * Converts a placed rect into a Vulkan viewport.
+     *
+     * @param ctx The context whose placed rect is converted.
+     * @param minDepth The minimum depth of the viewport.
+     * @param maxDepth The maximum depth of the viewport.
+     * @return A viewport covering the context's rect.
+     */
+    constexpr vk::Viewport MakeVKViewport(const RectSegmentContext& ctx, const float minDepth = 0.0f, const float maxDepth = 1.0f) noexcept {
+        return vk::Viewport{ctx.content.x, ctx.content.y, ctx.content.width, ctx.content.height, minDepth, maxDepth};
+    }
+
+    /**
+     * Converts the placed rects of a subtree into Vulkan viewports, in placement order.
+     *
+     * @param root The placed root of the subtree to convert.
+     * @param target The viewports receiving the result; extra rects are dropped.
+     * @param leavesOnly Whether only leaf contexts are converted.
+     * @param minDepth The minimum depth of every viewport.
+     * @param maxDepth The maximum depth of every viewport.
+     * @return The number of viewports written.
+     */
+    size_t MakeVKViewports(const RectSegmentContext& root, const std::span<vk::Viewport> target, const bool leavesOnly = false, const float minDepth = 0.0f, const float maxDepth = 1.0f) noexcept {
+        size_t count = 0;
+
+        const auto write = [&](const RectSegmentContext& ctx) noexcept {
+            if (count < target.size()) target[count++] = MakeVKViewport(ctx, minDepth, maxDepth);
+        };
+
+        if (leavesOnly) {
+            for (const auto& node : TraversePlacedLeaves(root)) write(*node.context);
+        }
+        else {
+            for (const auto& node : TraversePlacementOrder(root)) write(*node.context);
+        }
+
+        return count;
+    }
+
+    /**
+     * Converts the placed rects of a set of contexts into Vulkan viewports.
+     *
+     * @param nodes The contexts to convert; null entries get an empty viewport.
+     * @param target The viewports receiving the result, in the order of `nodes`; extra contexts are dropped.
+     * @param minDepth The minimum depth of every viewport.
+     * @param maxDepth The maximum depth of every viewport.
+     * @return The number of viewports written.
+     */
+    size_t MakeVKViewports(const std::span<const RectSegmentContext* const> nodes, const std::span<vk::Viewport> target, const float minDepth = 0.0f, const float maxDepth = 1.0f) noexcept {
+        const size_t count = std::min(nodes.size(), target.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            target[i] = nodes[i] != nullptr ? MakeVKViewport(*nodes[i], minDepth, maxDepth) : vk::Viewport{0.0f, 0.0f, 0.0f, 0.0f, minDepth, maxDepth};
+        }
+
+        return count;
+    }
+#endif
+
+}
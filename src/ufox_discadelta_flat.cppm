@@ -0,0 +1,246 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+export module ufox_discadelta_flat;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_simd;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Pre-computes the metrics of a single level of segments into reusable buffers.
+     *
+     * This is the library form of the chapter 3 pre-compute: every config is validated
+     * exactly like a childless `LinearSegmentContext`, stored structure-of-arrays, and
+     * the compression and expansion priorities are built with one sort each, so the
+     * pass runs in O(n log n). A direction in which no segment can clamp is flagged
+     * unconstrained and keeps its storage order without sorting. The buffers are resized in place, so once they have
+     * grown to the segment count, pre-computing again allocates nothing.
+     *
+     * Bases are clamped to their bounds and rounded for the rounded solve with the
+     * dispatched SIMD kernels, which give the same bits as the scalar code at every level.
+     *
+     * @param configs The segment configurations, one per segment.
+     * @param metrics The caller-owned buffers receiving the pre-computed metrics.
+     */
+    void PreComputeFlatMetrics(const std::span<const LinearSegmentCreateInfo> configs, FlatPreComputeMetrics& metrics) noexcept {
+        const size_t count = configs.size();
+
+        metrics.baseDistances.resize(count);
+        metrics.roundedBaseDistances.resize(count);
+        metrics.minDistances.resize(count);
+        metrics.maxDistances.resize(count);
+        metrics.compressCapacities.resize(count);
+        metrics.compressSolidifies.resize(count);
+        metrics.expandRatios.resize(count);
+        metrics.compressCascadePriorities.resize(count);
+        metrics.expandCascadePriorities.resize(count);
+        metrics.placementOrder.resize(count);
+
+        metrics.accumulatedBase = 0.0f;
+        metrics.accumulatedMin = 0.0f;
+        metrics.accumulatedCompressSolidify = 0.0f;
+        metrics.accumulatedExpandRatio = 0.0f;
+        metrics.compressUnconstrained = true;
+        metrics.expandUnconstrained = true;
+
+        for (size_t i = 0; i < count; ++i) {
+            const LinearSegmentCreateInfo& config = configs[i];
+
+            const float validatedMin = ChooseGreaterDistance(0.0f, config.min);
+            metrics.minDistances[i] = validatedMin;
+            metrics.maxDistances[i] = ChooseGreaterDistance(0.0f, validatedMin, config.max);
+            metrics.baseDistances[i] = ChooseGreaterDistance(0.0f, config.base);
+        }
+
+        // min(max(base, min), max) is std::clamp here, since every max is at least its min
+        ScaleClampFloats(metrics.baseDistances, 1.0f, metrics.minDistances, metrics.maxDistances, metrics.baseDistances);
+        RoundFloats(metrics.baseDistances, metrics.roundedBaseDistances);
+
+        for (size_t i = 0; i < count; ++i) {
+            const LinearSegmentCreateInfo& config = configs[i];
+
+            const float validatedMin = metrics.minDistances[i];
+            const float validatedMax = metrics.maxDistances[i];
+            const float validatedBase = metrics.baseDistances[i];
+            const float compressCapacity = validatedBase * ChooseGreaterDistance(0.0f, config.flexCompress);
+            const float compressSolidify = ChooseGreaterDistance(0.0f, validatedBase - compressCapacity);
+            const float expandRatio = ChooseGreaterDistance(0.0f, config.flexExpand);
+
+            metrics.compressCapacities[i] = compressCapacity;
+            metrics.compressSolidifies[i] = compressSolidify;
+            metrics.expandRatios[i] = expandRatio;
+
+            metrics.accumulatedBase += validatedBase;
+            metrics.accumulatedMin += ChooseGreaterDistance(validatedMin, compressSolidify);
+            metrics.accumulatedCompressSolidify += compressSolidify;
+            metrics.accumulatedExpandRatio += expandRatio;
+            metrics.compressUnconstrained = metrics.compressUnconstrained && validatedMin <= compressSolidify;
+            metrics.expandUnconstrained = metrics.expandUnconstrained && validatedMax >= std::numeric_limits<float>::max();
+        }
+
+        std::iota(metrics.compressCascadePriorities.begin(), metrics.compressCascadePriorities.end(), size_t{0});
+        std::iota(metrics.expandCascadePriorities.begin(), metrics.expandCascadePriorities.end(), size_t{0});
+        std::iota(metrics.placementOrder.begin(), metrics.placementOrder.end(), size_t{0});
+
+        const auto compressRoom = [&metrics](const size_t i) noexcept {
+            return ChooseGreaterDistance(0.0f, metrics.baseDistances[i] - metrics.minDistances[i]);
+        };
+        const auto expandRoom = [&metrics](const size_t i) noexcept {
+            return ChooseGreaterDistance(0.0f, metrics.maxDistances[i] - metrics.baseDistances[i]);
+        };
+
+        if (!metrics.compressUnconstrained) {
+            std::ranges::sort(metrics.compressCascadePriorities, [&compressRoom](const size_t a, const size_t b) noexcept {
+                const float roomA = compressRoom(a);
+                const float roomB = compressRoom(b);
+                return roomA < roomB || (roomA == roomB && a < b);
+            });
+        }
+
+        if (!metrics.expandUnconstrained) {
+            std::ranges::sort(metrics.expandCascadePriorities, [&expandRoom](const size_t a, const size_t b) noexcept {
+                const float roomA = expandRoom(a);
+                const float roomB = expandRoom(b);
+                return roomA > roomB || (roomA == roomB && a < b);
+            });
+        }
+
+        std::ranges::sort(metrics.placementOrder, [&configs](const size_t a, const size_t b) noexcept {
+            return configs[a].order < configs[b].order || (configs[a].order == configs[b].order && a < b);
+        });
+    }
+
+    /**
+     * Runs the compression cascade over pre-computed flat metrics.
+     *
+     * Segments are visited in compression priority and receive their share of the
+     * remaining distance in proportion to their compress capacity, on top of their
+     * solidified part and never below their minimum.
+     *
+     * @param metrics The pre-computed flat metrics.
+     * @param inputDistance The validated distance to distribute.
+     * @param round Whether distances are rounded to whole units.
+     * @param results The results, indexed like the configs; `base`, `expandDelta` and `distance` are written.
+     */
+    void FlatCompressing(const FlatPreComputeMetrics& metrics, const float inputDistance, const bool round, const std::span<LinearSegment> results) noexcept {
+        float cascadeCompressDistance = inputDistance;
+        float cascadeBaseDistance = round ? std::lroundf(metrics.accumulatedBase) : metrics.accumulatedBase;
+        float cascadeCompressSolidify = metrics.accumulatedCompressSolidify;
+
+        for (const size_t index : metrics.compressCascadePriorities) {
+            const float& solidify = metrics.compressSolidifies[index];
+            const float& validatedMin = metrics.minDistances[index];
+            const float base = round ? metrics.roundedBaseDistances[index] : metrics.baseDistances[index];
+
+            const float remainDist = cascadeCompressDistance - cascadeCompressSolidify;
+            const float remainCap = cascadeBaseDistance - cascadeCompressSolidify;
+            const float compressBaseDistance = Scaler(remainDist, remainCap, metrics.compressCapacities[index]) + solidify;
+            const float clampedDist = ChooseGreaterDistance(compressBaseDistance, validatedMin);
+            const float roundedDist = round ? std::lroundf(clampedDist) : clampedDist;
+
+            LinearSegment& result = results[index];
+            result.base = ChooseGreaterDistance(validatedMin, roundedDist);
+            result.expandDelta = 0.0f;
+            result.distance = result.base;
+
+            cascadeCompressDistance -= roundedDist;
+            cascadeCompressSolidify -= solidify;
+            cascadeBaseDistance -= base;
+        }
+    }
+
+    /**
+     * Runs the expansion cascade over pre-computed flat metrics.
+     *
+     * Segments keep their base and are visited in expansion priority, each receiving
+     * a share of the remaining delta in proportion to its expand ratio, capped by
+     * its maximum.
+     *
+     * @param metrics The pre-computed flat metrics.
+     * @param inputDistance The validated distance to distribute.
+     * @param round Whether distances are rounded to whole units.
+     * @param results The results, indexed like the configs; `base`, `expandDelta` and `distance` are written.
+     */
+    void FlatExpanding(const FlatPreComputeMetrics& metrics, const float inputDistance, const bool round, const std::span<LinearSegment> results) noexcept {
+        const float accumulatedBase = round ? std::lroundf(metrics.accumulatedBase) : metrics.accumulatedBase;
+        float cascadeExpandDelta = ChooseGreaterDistance(inputDistance - accumulatedBase, 0.0f);
+        float cascadeExpandRatio = metrics.accumulatedExpandRatio;
+
+        for (const size_t index : metrics.expandCascadePriorities) {
+            const float& expandRatio = metrics.expandRatios[index];
+            const float base = round ? metrics.roundedBaseDistances[index] : metrics.baseDistances[index];
+            const float maxDelta = ChooseGreaterDistance(0.0f, metrics.maxDistances[index] - base);
+
+            const float expandDelta = Scaler(cascadeExpandDelta, cascadeExpandRatio, expandRatio);
+            const float clampedDelta = ChooseLowestDistance(expandDelta, maxDelta);
+            const float roundedDelta = round ? std::lroundf(clampedDelta) : clampedDelta;
+
+            LinearSegment& result = results[index];
+            result.base = ChooseGreaterDistance(metrics.minDistances[index], base);
+            result.expandDelta = roundedDelta;
+            result.distance = result.base + roundedDelta;
+
+            cascadeExpandDelta -= roundedDelta;
+            cascadeExpandRatio -= expandRatio;
+        }
+    }
+
+    /**
+     * Assigns offsets to solved flat segments following their configured `order`.
+     *
+     * @param metrics The pre-computed flat metrics holding the placement order.
+     * @param results The solved results, indexed like the configs; `offset` is written.
+     * @param startOffset The offset of the first placed segment.
+     */
+    void FlatPlacing(const FlatPreComputeMetrics& metrics, const std::span<LinearSegment> results, const float startOffset = 0.0f) noexcept {
+        float currentOffset = startOffset;
+
+        for (const size_t index : metrics.placementOrder) {
+            results[index].offset = currentOffset;
+            currentOffset += results[index].distance;
+        }
+    }
+
+    /**
+     * Solves a single level of segments for a given distance without any allocation.
+     *
+     * Chooses compression or expansion like `Sizing` does for a linear context whose
+     * children are the flat segments, then places them. The result of one call is
+     * the same as a one-level `LinearSegmentContext` tree solved for that distance.
+     *
+     * @param metrics The metrics produced by `PreComputeFlatMetrics`.
+     * @param inputDistance The distance to distribute across the segments.
+     * @param round Whether distances are rounded to whole units.
+     * @param results The caller-owned results, one per config; names and orders are left untouched.
+     * @return True if the segments were compressed, false if they were expanded.
+     */
+    bool SolveFlatSegments(const FlatPreComputeMetrics& metrics, const float inputDistance, const bool round, const std::span<LinearSegment> results) noexcept {
+        const float validatedInputDistance = ChooseGreaterDistance(metrics.accumulatedMin, inputDistance);
+        const float roundedBase = round ? std::lroundf(metrics.accumulatedBase) : metrics.accumulatedBase;
+        const bool processingCompression = validatedInputDistance < roundedBase;
+
+        if (processingCompression) {
+            FlatCompressing(metrics, validatedInputDistance, round, results);
+        }
+        else {
+            FlatExpanding(metrics, validatedInputDistance, round, results);
+        }
+
+        FlatPlacing(metrics, results);
+
+        return processingCompression;
+    }
+
+}
@@ -3,7 +3,13 @@
 //
 module;
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +30,36 @@ export namespace ufox::geometry::discadelta {
         Row,
     };
 
+    enum class DistributionMode {
+        Proportional,
+        Equal,
+        IntegerWeighted,
+        SnapToGrid,
+    };
+
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        SSE41,
+        AVX2,
+        AVX512,
+    };
+
+    enum class SegmentSolveStrategy {
+        Cascade,
+        ParallelDescent,
+    };
+
+    struct SegmentNodeFeatures {
+        size_t fanout{0};
+        size_t branchCount{1};
+    };
+
+    struct SegmentStrategyThresholds {
+        size_t radixFanout{512};
+        size_t parallelBranchCount{16384};
+    };
+
     struct LinearSegment {
         std::string name{"none"};
         float base{0.0f};
@@ -46,6 +82,70 @@ export namespace ufox::geometry::discadelta {
         size_t order{0};
     };
 
+    struct RectInstance {
+        int16_t x{0};
+        int16_t y{0};
+        uint16_t width{0};
+        uint16_t height{0};
+        uint16_t depth{0};
+        uint16_t reserved{0};
+        uint32_t nodeId{0};
+    };
+
+    struct RectExportBuffer {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> width;
+        std::vector<float> height;
+        std::vector<uint16_t> depth;
+        std::vector<uint32_t> nodeId;
+    };
+
+    struct RectLodExportBuffer {
+        RectExportBuffer rects;
+        std::vector<uint32_t> segmentCount;
+    };
+
+    struct SharedRectRingCreateInfo {
+        std::string name;
+        uint32_t slotCount{3};
+        uint32_t capacity{0};
+        bool replaceExisting{false};
+    };
+
+    struct SharedRectRingHeader {
+        uint32_t magic{0};
+        uint32_t version{0};
+        uint32_t slotCount{0};
+        uint32_t capacity{0};
+        uint64_t slotStride{0};
+        std::atomic<uint64_t> publishedSequence{0};
+    };
+
+    struct SharedRectSlotHeader {
+        std::atomic<uint64_t> sequence{0};
+        uint32_t count{0};
+        uint32_t reserved{0};
+    };
+
+    struct SharedRectRing {
+        std::string name;
+        std::byte* mapping{nullptr};
+        size_t mappingSize{0};
+        bool owner{false};
+        uint64_t nextSequence{1};
+    };
+
+    struct SharedRectFrame {
+        uint64_t sequence{0};
+        std::span<const float> x;
+        std::span<const float> y;
+        std::span<const float> width;
+        std::span<const float> height;
+        std::span<const uint32_t> nodeId;
+        std::span<const uint16_t> depth;
+    };
+
     struct LinearSegmentCreateInfo {
         std::string name{"none"};
         float base{0.0f};
@@ -54,6 +154,8 @@ export namespace ufox::geometry::discadelta {
         float min{};
         float max{};
         size_t order;
+        DistributionMode distribution{DistributionMode::Proportional};
+        float gridStep{1.0f};
     };
 
     struct RectSegmentCreateInfo {
@@ -68,6 +170,68 @@ export namespace ufox::geometry::discadelta {
         float flexCompress{0.0f};
         float flexExpand{0.0f};
         size_t order{0};
+        DistributionMode distribution{DistributionMode::Proportional};
+        float gridStep{1.0f};
+    };
+
+    struct FlatPreComputeMetrics {
+        std::vector<float> baseDistances;
+        std::vector<float> roundedBaseDistances;
+        std::vector<float> minDistances;
+        std::vector<float> maxDistances;
+        std::vector<float> compressCapacities;
+        std::vector<float> compressSolidifies;
+        std::vector<float> expandRatios;
+        std::vector<size_t> compressCascadePriorities;
+        std::vector<size_t> expandCascadePriorities;
+        std::vector<size_t> placementOrder;
+        bool compressUnconstrained{false};
+        bool expandUnconstrained{false};
+        float accumulatedBase{0.0f};
+        float accumulatedMin{0.0f};
+        float accumulatedCompressSolidify{0.0f};
+        float accumulatedExpandRatio{0.0f};
+    };
+
+    struct SegmentStreamRecord {
+        float base{0.0f};
+        float flexCompress{0.0f};
+        float flexExpand{0.0f};
+        float min{0.0f};
+        float max{0.0f};
+    };
+
+    struct SegmentStreamResult {
+        float distance{0.0f};
+        float reserved{0.0f};
+        double offset{0.0};
+    };
+
+    struct SegmentStreamBucket {
+        double boundSum{0.0};
+        double freeSum{0.0};
+        double slopeSum{0.0};
+        float lowestThreshold{0.0f};
+        float highestThreshold{0.0f};
+        uint64_t count{0};
+    };
+
+    struct SegmentStreamAccumulator {
+        uint64_t segmentCount{0};
+        double accumulatedBase{0.0};
+        double accumulatedMin{0.0};
+        double accumulatedCompressSolidify{0.0};
+        double accumulatedExpandRatio{0.0};
+        double fixedCompressDistance{0.0};
+        std::vector<SegmentStreamBucket> compressThresholds;
+        std::vector<SegmentStreamBucket> expandThresholds;
+    };
+
+    struct SegmentStreamSolution {
+        uint64_t segmentCount{0};
+        float inputDistance{0.0f};
+        bool compressing{false};
+        double scale{0.0};
     };
 
     struct LinearSegmentContext {
@@ -78,6 +242,11 @@ export namespace ufox::geometry::discadelta {
         std::unordered_map<std::string, size_t> childrenIndies;
         std::vector<size_t> compressCascadePriorities;
         std::vector<size_t> expandCascadePriorities;
+        std::vector<size_t> placementOrder;
+        bool compressUnconstrained{false};
+        bool expandUnconstrained{false};
+        SegmentNodeFeatures features{};
+        SegmentSolveStrategy strategy{SegmentSolveStrategy::Cascade};
 
         float validatedBase = 0.0f;
         float validatedMin = 0.0f;
@@ -91,7 +260,11 @@ export namespace ufox::geometry::discadelta {
         float compressCapacity = 0.0f;
         float compressSolidify = 0.0f;
         size_t order{0};
+        size_t siblingIndex{0};
+        size_t placementIndex{0};
+        size_t resultIndex{0};
         size_t branchCount = 1;
+        uint64_t structureGeneration{0};
         Hash hash{0};
 
         explicit LinearSegmentContext(LinearSegmentCreateInfo config) : config(std::move(config)) {}
@@ -105,6 +278,11 @@ export namespace ufox::geometry::discadelta {
         std::unordered_map<std::string, size_t> childrenIndies;
         std::vector<size_t> compressCascadePriorities;
         std::vector<size_t> expandCascadePriorities;
+        std::vector<size_t> placementOrder;
+        bool compressUnconstrained{false};
+        bool expandUnconstrained{false};
+        SegmentNodeFeatures features{};
+        SegmentSolveStrategy strategy{SegmentSolveStrategy::Cascade};
         float validatedWidthBase = 0.0f;
         float validatedHeightBase = 0.0f;
         float validatedWidthMin = 0.0f;
@@ -124,10 +302,89 @@ export namespace ufox::geometry::discadelta {
         float heightCompressSolidify = 0.0f;
         float expandRatio = 0.0f;
         size_t order{0};
+        size_t siblingIndex{0};
+        size_t placementIndex{0};
+        size_t resultIndex{0};
         size_t branchCount = 1;
+        uint64_t structureGeneration{0};
         Hash hash{0};
 
         explicit RectSegmentContext(RectSegmentCreateInfo  config) : config(std::move(config)) {}
     };
 
+    struct alignas(64) SegmentReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+        uint32_t depth{0};
+    };
+
+    struct SegmentRetiredContext {
+        void* context{nullptr};
+        void (*destroy)(void*) noexcept {nullptr};
+        uint64_t epoch{0};
+    };
+
+    struct SegmentReclaimDomain {
+        std::atomic<uint64_t> epoch{1};
+        std::array<SegmentReaderSlot, 64> readers{};
+        std::mutex retiredMutex;
+        std::vector<SegmentRetiredContext> retired;
+
+        SegmentReclaimDomain() = default;
+        SegmentReclaimDomain(const SegmentReclaimDomain&) = delete;
+        SegmentReclaimDomain& operator=(const SegmentReclaimDomain&) = delete;
+
+        ~SegmentReclaimDomain() {
+            for (const auto& entry : retired) entry.destroy(entry.context);
+        }
+    };
+
+    struct RectTransition {
+        std::vector<RectSegmentContext*> nodes;
+        std::vector<size_t> depths;
+        RectExportBuffer start;
+        RectExportBuffer end;
+    };
+
+    struct SegmentLayoutRequest {
+        float mainInput{0.0f};
+        float crossInput{0.0f};
+        bool round{false};
+    };
+
+    struct SegmentSchedulerStats {
+        uint64_t frames{0};
+        uint64_t idleFrames{0};
+        uint64_t invalidations{0};
+        uint64_t resizeRequests{0};
+        uint64_t coalescedRequests{0};
+        uint64_t recomputedContexts{0};
+        uint64_t solves{0};
+    };
+
+    struct LinearFrameScheduler {
+        LinearSegmentContext* root{nullptr};
+        std::vector<LinearSegmentContext*> dirty;
+        float inputDistance{0.0f};
+        bool round{false};
+        bool hasInput{false};
+        bool resizePending{false};
+        SegmentSchedulerStats pending{};
+        SegmentSchedulerStats lastFrame{};
+        SegmentSchedulerStats total{};
+    };
+
+    struct RectFrameScheduler {
+        RectSegmentContext* root{nullptr};
+        std::vector<RectSegmentContext*> dirty;
+        float mainInput{0.0f};
+        float crossInput{0.0f};
+        bool round{false};
+        bool hasInput{false};
+        bool resizePending{false};
+        SegmentSchedulerStats pending{};
+        SegmentSchedulerStats lastFrame{};
+        SegmentSchedulerStats total{};
+    };
+
 }
@@ -0,0 +1,375 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module ufox_discadelta_parallel;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Resolves the number of workers to use for a parallel pass.
+     *
+     * A request of zero selects the hardware concurrency of the host, which is
+     * itself clamped to at least one worker when the runtime cannot report it.
+     *
+     * @param requested The requested worker count, or zero for the host default.
+     * @return The effective worker count, always greater than zero.
+     */
+    [[nodiscard]] inline size_t ResolveWorkerCount(const size_t requested) noexcept {
+        if (requested > 0) return requested;
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    template<typename FuncT>
+    /**
+     * Runs a function over an index range split into contiguous chunks across workers.
+     *
+     * The calling thread processes the first chunk itself, so a range smaller than
+     * `minChunk` or a single worker runs inline without spawning any thread. The
+     * function must be safe to call concurrently for distinct indices.
+     *
+     * @param count The number of indices to process, `[0, count)`.
+     * @param workerCount The maximum number of workers, or zero for the host default.
+     * @param minChunk The minimum number of indices handed to one worker.
+     * @param func The callable invoked as `func(index)` for every index.
+     */
+    void ParallelFor(const size_t count, const size_t workerCount, const size_t minChunk, FuncT&& func) {
+        if (count == 0) return;
+
+        const size_t maxWorkers = (count + std::max<size_t>(1, minChunk) - 1) / std::max<size_t>(1, minChunk);
+        const size_t workers = std::min(ResolveWorkerCount(workerCount), maxWorkers);
+
+        if (workers <= 1) {
+            for (size_t i = 0; i < count; ++i) func(i);
+            return;
+        }
+
+        const size_t chunk = (count + workers - 1) / workers;
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+
+        for (size_t w = 1; w < workers; ++w) {
+            const size_t begin = w * chunk;
+            const size_t end = std::min(count, begin + chunk);
+            if (begin >= end) break;
+            threads.emplace_back([&func, begin, end] {
+                for (size_t i = begin; i < end; ++i) func(i);
+            });
+        }
+
+        for (size_t i = 0; i < std::min(count, chunk); ++i) func(i);
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Groups a dirty set and all of its ancestors by depth, each node exactly once.
+     *
+     * Walking up from a dirty node stops at the first ancestor that has already been
+     * collected, so shared ancestor chains are visited once no matter how many dirty
+     * nodes sit beneath them. The result is indexed by depth, with the tree roots at
+     * level zero.
+     *
+     * @param dirty The contexts whose own configuration or children have changed.
+     * @return The affected contexts bucketed by depth, shallowest level first.
+     */
+    [[nodiscard]] std::vector<std::vector<ContextT*>> MakeDirtyLevels(const std::span<ContextT* const> dirty) {
+        std::unordered_map<ContextT*, size_t> depths;
+        depths.reserve(dirty.size() * 2);
+
+        std::vector<ContextT*> chain;
+        std::vector<std::vector<ContextT*>> levels;
+
+        for (ContextT* node : dirty) {
+            if (node == nullptr || depths.contains(node)) continue;
+
+            chain.clear();
+            size_t knownDepth = 0;
+            bool reachedKnown = false;
+
+            for (ContextT* current = node; current != nullptr; current = ValidateContextParent(*current) ? current->parent : nullptr) {
+                if (const auto it = depths.find(current); it != depths.end()) {
+                    knownDepth = it->second;
+                    reachedKnown = true;
+                    break;
+                }
+                chain.push_back(current);
+            }
+
+            // chain runs bottom-up; the last entry sits right below the known ancestor (or is a root)
+            const size_t topDepth = reachedKnown ? knownDepth + 1 : 0;
+            const size_t bottomDepth = topDepth + chain.size() - 1;
+            if (levels.size() <= bottomDepth) levels.resize(bottomDepth + 1);
+
+            for (size_t i = 0; i < chain.size(); ++i) {
+                const size_t depth = bottomDepth - i;
+                depths.emplace(chain[i], depth);
+                levels[depth].push_back(chain[i]);
+            }
+        }
+
+        return levels;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Recomputes the pre-compute metrics of a batch of dirty contexts level by level.
+     *
+     * This is the batched counterpart of calling `UpdateContextMetrics` once per dirty
+     * node. The dirty set and its ancestors are grouped by depth, then every level is
+     * processed from the deepest up, with all nodes of one level recomputed in parallel.
+     * Each affected context runs `UpdateAccumulatedMetrics`, `ValidateContextMetrics`
+     * and `UpdatePriorityLists` exactly once, after all of its dirty descendants.
+     *
+     * Nodes of one level only write their own metrics and only read their children,
+     * which belong to a level that is already finished, so no locking is required.
+     * The tree must not be mutated by other threads while the recompute runs.
+     *
+     * @param dirty The contexts whose configuration or children have changed.
+     * @param workerCount The maximum number of workers per level, or zero for the host default.
+     * @return The number of contexts that were recomputed.
+     */
+    size_t RecomputeDirtyMetrics(const std::span<ContextT* const> dirty, const size_t workerCount = 0) {
+        constexpr size_t minNodesPerWorker = 64;
+
+        const auto levels = MakeDirtyLevels(dirty);
+        size_t recomputed = 0;
+
+        for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+            const auto& nodes = *level;
+
+            ParallelFor(nodes.size(), workerCount, minNodesPerWorker, [&nodes](const size_t i) noexcept {
+                ContextT& ctx = *nodes[i];
+                UpdateAccumulatedMetrics(ctx);
+                ValidateContextMetrics(ctx);
+                UpdatePriorityLists(ctx);
+            });
+
+            recomputed += nodes.size();
+        }
+
+        return recomputed;
+    }
+
+
+    /**
+     * Splits a worker budget between the children handed to a parallel node.
+     *
+     * @param budget The workers available to the node, at least one.
+     * @param childCount The number of children to size.
+     * @return The number of workers the node runs, and the budget each of them passes down.
+     */
+    [[nodiscard]] constexpr std::pair<size_t, size_t> SplitWorkerBudget(const size_t budget, const size_t childCount) noexcept {
+        const size_t workers = std::max<size_t>(1, std::min(budget, childCount));
+        return {workers, std::max<size_t>(1, budget / workers)};
+    }
+
+    /**
+     * Sizes a linear subtree, solving the children of `ParallelDescent` nodes concurrently.
+     *
+     * A node whose pre-compute picked `ParallelDescent` runs its own cascade, then hands
+     * every child it reached to `ParallelFor`, and each child subtree is sized again from
+     * the base and delta it was given; every other node is sized with `Sizing`. The
+     * results are the same as a sequential `Sizing`.
+     *
+     * The worker count is a budget for the whole subtree: a parallel node splits what it
+     * was given between its workers, and nodes reached with a budget of one are sized
+     * sequentially, so nested parallel nodes never run more threads than requested.
+     *
+     * @param ctx The context to size.
+     * @param value The input distance of the context.
+     * @param delta The expand delta of the context.
+     * @param round Whether distances are rounded to whole units.
+     * @param workerCount The maximum number of workers for the subtree, or zero for the host default.
+     */
+    void ParallelSizing(LinearSegmentContext& ctx, const float value, const float delta, const bool round, const size_t workerCount = 0) {
+        const size_t budget = ResolveWorkerCount(workerCount);
+        if (ctx.strategy != SegmentSolveStrategy::ParallelDescent || budget <= 1) {
+            Sizing(ctx, value, delta, round);
+            return;
+        }
+
+        std::vector<LinearSegmentContext*> deferred;
+        deferred.reserve(ctx.children.size());
+        Sizing(ctx, value, delta, round, {}, DeferredSegmentResults<LinearSegmentContext>{&ctx, &deferred});
+
+        const auto [workers, childBudget] = SplitWorkerBudget(budget, deferred.size());
+        ParallelFor(deferred.size(), workers, 1, [&deferred, round, workerBudget = childBudget](const size_t i) {
+            LinearSegmentContext& child = *deferred[i];
+            ParallelSizing(child, child.content.base, child.content.expandDelta, round, workerBudget);
+        });
+    }
+
+    /**
+     * Sizes a rectangular subtree, solving the children of `ParallelDescent` nodes concurrently.
+     *
+     * This is the rectangular counterpart of the linear `ParallelSizing`.
+     *
+     * @param ctx The context to size.
+     * @param width The input width of the context.
+     * @param height The input height of the context.
+     * @param widthDelta The width expand delta of the context.
+     * @param heightDelta The height expand delta of the context.
+     * @param round Whether distances are rounded to whole units.
+     * @param workerCount The maximum number of workers for the subtree, or zero for the host default.
+     */
+    void ParallelSizing(RectSegmentContext& ctx, const float width, const float height, const float widthDelta, const float heightDelta, const bool round, const size_t workerCount = 0) {
+        const size_t budget = ResolveWorkerCount(workerCount);
+        if (ctx.strategy != SegmentSolveStrategy::ParallelDescent || budget <= 1) {
+            Sizing(ctx, width, height, widthDelta, heightDelta, round);
+            return;
+        }
+
+        std::vector<RectSegmentContext*> deferred;
+        deferred.reserve(ctx.children.size());
+        Sizing(ctx, width, height, widthDelta, heightDelta, round, {}, DeferredSegmentResults<RectSegmentContext>{&ctx, &deferred});
+
+        const auto [workers, childBudget] = SplitWorkerBudget(budget, deferred.size());
+        ParallelFor(deferred.size(), workers, 1, [&deferred, round, workerBudget = childBudget](const size_t i) {
+            RectSegmentContext& child = *deferred[i];
+            const RectSegment& content = child.content;
+            ParallelSizing(child, content.widthBase, content.heightBase, content.widthExpandDelta, content.heightExpandDelta, round, workerBudget);
+        });
+    }
+
+    /**
+     * Sizes a linear tree with `ParallelSizing`, then places it.
+     *
+     * @param rootCtx The root of the tree.
+     * @param inputDistance The distance of the root.
+     * @param round Whether distances are rounded to whole units.
+     * @param workerCount The maximum number of workers per parallel node, or zero for the host default.
+     */
+    void ParallelUpdateSegments(LinearSegmentContext& rootCtx, const float inputDistance, const bool round, const size_t workerCount = 0) {
+        ParallelSizing(rootCtx, inputDistance, 0.0f, round, workerCount);
+        Placing(rootCtx);
+    }
+
+    /**
+     * Sizes a rectangular tree with `ParallelSizing`, then places it.
+     *
+     * @param rootCtx The root of the tree.
+     * @param mainInput The main-axis size of the root.
+     * @param crossInput The cross-axis size of the root.
+     * @param round Whether distances are rounded to whole units.
+     * @param workerCount The maximum number of workers per parallel node, or zero for the host default.
+     */
+    void ParallelUpdateSegments(RectSegmentContext& rootCtx, const float mainInput, const float crossInput, const bool round, const size_t workerCount = 0) {
+        ParallelSizing(rootCtx, mainInput, crossInput, 0.0f, 0.0f, round, workerCount);
+        Placing(rootCtx);
+    }
+
+    template<typename FuncT>
+    /**
+     * Returns the fastest of a few timed runs of a function, in nanoseconds.
+     *
+     * @param repeats The number of timed runs.
+     * @param func The function to time.
+     * @return The shortest run.
+     */
+    [[nodiscard]] int64_t MeasureFastestRun(const size_t repeats, FuncT&& func) {
+        auto best = std::chrono::nanoseconds::max();
+        for (size_t i = 0; i < repeats; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return best.count();
+    }
+
+    /**
+     * Measures the host to find where the radix ordering and the parallel descent start paying off.
+     *
+     * The radix threshold is the smallest fanout, doubling from 64, at which
+     * `SortCascadePriorities` runs faster with the radix sort than with the comparison
+     * sort. The parallel threshold is the smallest subtree, doubling from 4096 nodes,
+     * that `ParallelSizing` solves faster than `Sizing`; a host with a single worker
+     * never descends in parallel. The benchmark builds its own throwaway trees and
+     * takes a fraction of a second, so it is meant to run once at startup:
+     *
+     * `SetSegmentStrategyThresholds(CalibrateSegmentStrategies());`
+     *
+     * @param workerCount The worker count the parallel passes will use, or zero for the host default.
+     * @return The calibrated thresholds.
+     */
+    [[nodiscard]] SegmentStrategyThresholds CalibrateSegmentStrategies(const size_t workerCount = 0) {
+        constexpr size_t repeats = 5;
+        constexpr size_t maxFanout = size_t{1} << 16;
+        constexpr size_t maxBranchCount = size_t{1} << 18;
+        constexpr size_t calibrationFanout = 32;
+
+        SegmentStrategyThresholds thresholds{.radixFanout = std::numeric_limits<size_t>::max(), .parallelBranchCount = std::numeric_limits<size_t>::max()};
+        std::mt19937 random(0x5eed);
+        std::uniform_real_distribution<float> distribution(0.0f, 256.0f);
+
+        std::vector<std::pair<float, size_t>> source;
+        std::vector<std::pair<float, size_t>> work;
+        for (size_t fanout = 64; fanout <= maxFanout; fanout *= 2) {
+            source.resize(fanout);
+            for (size_t i = 0; i < fanout; ++i) source[i] = {distribution(random), i};
+
+            const int64_t comparison = MeasureFastestRun(repeats, [&] { work = source; SortCascadePriorities(work, false, false); });
+            const int64_t radix = MeasureFastestRun(repeats, [&] { work = source; SortCascadePriorities(work, false, true); });
+            if (radix < comparison) {
+                thresholds.radixFanout = fanout;
+                break;
+            }
+        }
+
+        if (ResolveWorkerCount(workerCount) <= 1) return thresholds;
+
+        for (size_t branchCount = 4096; branchCount <= maxBranchCount; branchCount *= 2) {
+            const size_t leavesPerChild = branchCount / calibrationFanout;
+
+            std::vector<LinearSegmentContext> nodes;
+            nodes.reserve(1 + calibrationFanout * (1 + leavesPerChild));
+            LinearSegmentContext& root = nodes.emplace_back(LinearSegmentCreateInfo{.name = "root", .max = std::numeric_limits<float>::max(), .order = 0});
+
+            for (size_t c = 0; c < calibrationFanout; ++c) {
+                LinearSegmentContext& child = nodes.emplace_back(LinearSegmentCreateInfo{.name = std::to_string(c), .flexCompress = 1.0f, .flexExpand = 1.0f, .max = std::numeric_limits<float>::max(), .order = c});
+                for (size_t l = 0; l < leavesPerChild; ++l) {
+                    const float base = distribution(random);
+                    LinearSegmentContext& leaf = nodes.emplace_back(LinearSegmentCreateInfo{
+                        .name = std::to_string(l), .base = base, .flexCompress = 0.5f, .flexExpand = 1.0f,
+                        .min = (l % 3 == 0) ? base * 0.5f : 0.0f, .max = (l % 5 == 0) ? base * 2.0f : std::numeric_limits<float>::max(), .order = l});
+                    Attach(child, leaf);
+                }
+                Attach(root, child);
+            }
+
+            std::vector<LinearSegmentContext*> dirty;
+            dirty.reserve(nodes.size());
+            for (auto& node : nodes) dirty.push_back(&node);
+            RecomputeDirtyMetrics(std::span<LinearSegmentContext* const>(dirty), workerCount);
+
+            const float inputDistance = root.accumulatedBase * 0.75f;
+            root.strategy = SegmentSolveStrategy::Cascade;
+            const int64_t sequential = MeasureFastestRun(repeats, [&] { ParallelSizing(root, inputDistance, 0.0f, false, workerCount); });
+            root.strategy = SegmentSolveStrategy::ParallelDescent;
+            const int64_t parallel = MeasureFastestRun(repeats, [&] { ParallelSizing(root, inputDistance, 0.0f, false, workerCount); });
+            if (parallel < sequential) {
+                thresholds.parallelBranchCount = branchCount;
+                break;
+            }
+        }
+
+        return thresholds;
+    }
+
+}
@@ -0,0 +1,206 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+export module ufox_discadelta_reclaim;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Claims a free reader slot of a reclamation domain for the calling thread.
+     *
+     * A slot belongs to one reader thread at a time and is reused for all of its read
+     * epochs; claiming is the only step of the read side that may contend.
+     *
+     * @param domain The domain the thread reads under.
+     * @return The claimed slot, or null if every slot is taken.
+     */
+    [[nodiscard]] SegmentReaderSlot* AcquireReaderSlot(SegmentReclaimDomain& domain) noexcept {
+        for (auto& slot : domain.readers) {
+            bool expected = false;
+            if (slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot.depth = 0;
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Returns a reader slot to its domain.
+     *
+     * @param slot A slot claimed with `AcquireReaderSlot`, outside any read epoch.
+     */
+    void ReleaseReaderSlot(SegmentReaderSlot* slot) noexcept {
+        if (!slot) return;
+
+        slot->epoch.store(0, std::memory_order_release);
+        slot->claimed.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Enters a read epoch, from which every context reachable now stays allocated.
+     *
+     * The slot publishes the current epoch and confirms it has not moved meanwhile,
+     * so a reclaim pass either sees the reader or started after every context the
+     * reader can reach was already in the tree. No lock is taken. Epochs nest; only
+     * the outermost one is published.
+     *
+     * @param domain The domain the slot belongs to.
+     * @param slot The reader's slot.
+     */
+    void EnterReadEpoch(const SegmentReclaimDomain& domain, SegmentReaderSlot& slot) noexcept {
+        if (slot.depth++ != 0) return;
+
+        uint64_t epoch = domain.epoch.load();
+        while (true) {
+            slot.epoch.store(epoch);
+            const uint64_t current = domain.epoch.load();
+            if (current == epoch) return;
+            epoch = current;
+        }
+    }
+
+    /**
+     * Leaves a read epoch. Pointers obtained inside it must not be used afterwards.
+     *
+     * @param slot The reader's slot.
+     */
+    void ExitReadEpoch(SegmentReaderSlot& slot) noexcept {
+        if (slot.depth == 0 || --slot.depth != 0) return;
+
+        slot.epoch.store(0, std::memory_order_release);
+    }
+
+    /**
+     * Keeps a reader slot inside a read epoch for the lifetime of the guard.
+     */
+    class SegmentReadGuard {
+    public:
+        SegmentReadGuard(const SegmentReclaimDomain& domain, SegmentReaderSlot& slot) noexcept : slot(&slot) {
+            EnterReadEpoch(domain, slot);
+        }
+
+        SegmentReadGuard(const SegmentReadGuard&) = delete;
+        SegmentReadGuard& operator=(const SegmentReadGuard&) = delete;
+
+        ~SegmentReadGuard() {
+            ExitReadEpoch(*slot);
+        }
+
+    private:
+        SegmentReaderSlot* slot;
+    };
+
+    /**
+     * Returns the oldest epoch a reader of the domain is still inside.
+     *
+     * @param domain The domain to scan.
+     * @return The oldest published epoch, or the maximum value if no reader is inside one.
+     */
+    [[nodiscard]] uint64_t GetOldestReadEpoch(const SegmentReclaimDomain& domain) noexcept {
+        uint64_t oldest = std::numeric_limits<uint64_t>::max();
+        for (const auto& slot : domain.readers) {
+            const uint64_t epoch = slot.epoch.load();
+            if (epoch != 0) oldest = std::min(oldest, epoch);
+        }
+        return oldest;
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Unlinks a context like `DestroySegmentContext`, but defers freeing it until no reader can hold it.
+     *
+     * The context is detached from its parent and children right away, exactly as a
+     * destroy would do, and stamped with the epoch that ends with its removal. Readers
+     * that entered their epoch before may keep reading it; the memory is released by
+     * the first `ReclaimSegmentContexts` after all of them have left. Only the memory
+     * is protected: structural edits to the live tree still have to be published to
+     * readers by the caller, for instance through snapshots.
+     *
+     * @param domain The domain shared with the readers.
+     * @param ptr The context to retire, owned by the caller until now. Null is ignored.
+     */
+    void RetireSegmentContext(SegmentReclaimDomain& domain, ContextT* ptr) {
+        if (!ptr) return;
+
+        while (!ptr->children.empty()) {
+            Unlink(*ptr->children.front());
+        }
+        if (ptr->parent != nullptr) Unlink(*ptr);
+
+        std::scoped_lock lock(domain.retiredMutex);
+        domain.retired.push_back({
+            .context = ptr,
+            .destroy = [](void* context) noexcept { delete static_cast<ContextT*>(context); },
+            .epoch = domain.epoch.fetch_add(1),
+        });
+    }
+
+    template<typename ContextT>
+    requires std::same_as<ContextT, LinearSegmentContext> || std::same_as<ContextT, RectSegmentContext>
+    /**
+     * Retires a context owned by a handler returned from `CreateSegmentContext`.
+     *
+     * @param domain The domain shared with the readers.
+     * @param handler The handler giving up ownership; it is left empty.
+     */
+    void RetireSegmentContext(SegmentReclaimDomain& domain, std::unique_ptr<ContextT, decltype(&DestroySegmentContext<ContextT>)>& handler) {
+        RetireSegmentContext(domain, handler.release());
+    }
+
+    /**
+     * Frees every retired context that no reader can still hold.
+     *
+     * A context retired at an epoch is freed once every reader inside an epoch entered
+     * it after that one. Destruction runs outside the domain lock. Call it regularly
+     * from the writer, for instance once per frame; it never waits for readers.
+     *
+     * @param domain The domain to reclaim.
+     * @return The number of freed contexts.
+     */
+    size_t ReclaimSegmentContexts(SegmentReclaimDomain& domain) {
+        std::vector<SegmentRetiredContext> released;
+        {
+            std::scoped_lock lock(domain.retiredMutex);
+            if (domain.retired.empty()) return 0;
+
+            // Entries retired before the oldest published epoch are moved to the back
+            const uint64_t oldest = GetOldestReadEpoch(domain);
+            const auto releasable = std::ranges::partition(domain.retired, [oldest](const SegmentRetiredContext& entry) {
+                return entry.epoch >= oldest;
+            });
+            released.assign(releasable.begin(), releasable.end());
+            domain.retired.erase(releasable.begin(), releasable.end());
+        }
+
+        for (const auto& entry : released) entry.destroy(entry.context);
+        return released.size();
+    }
+
+    /**
+     * Returns the number of retired contexts still waiting for readers to leave.
+     *
+     * @param domain The domain to inspect.
+     * @return The number of pending contexts.
+     */
+    [[nodiscard]] size_t GetPendingRetiredCount(SegmentReclaimDomain& domain) {
+        std::scoped_lock lock(domain.retiredMutex);
+        return domain.retired.size();
+    }
+
+}
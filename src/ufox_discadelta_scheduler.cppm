@@ -0,0 +1,178 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+export module ufox_discadelta_scheduler;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+import ufox_discadelta_parallel;
+
+export namespace ufox::geometry::discadelta {
+
+    template<typename SchedulerT>
+    concept FrameScheduler = std::same_as<SchedulerT, LinearFrameScheduler> || std::same_as<SchedulerT, RectFrameScheduler>;
+
+    template<typename SchedulerT>
+    requires FrameScheduler<SchedulerT>
+    using FrameSchedulerContext = std::remove_pointer_t<decltype(SchedulerT::root)>;
+
+    /**
+     * Accumulates two scheduler statistics, field by field.
+     *
+     * @param target The statistics receiving the sum.
+     * @param value The statistics to add.
+     */
+    constexpr void AccumulateSchedulerStats(SegmentSchedulerStats& target, const SegmentSchedulerStats& value) noexcept {
+        target.frames += value.frames;
+        target.idleFrames += value.idleFrames;
+        target.invalidations += value.invalidations;
+        target.resizeRequests += value.resizeRequests;
+        target.coalescedRequests += value.coalescedRequests;
+        target.recomputedContexts += value.recomputedContexts;
+        target.solves += value.solves;
+    }
+
+    /**
+     * Records the size the root of a linear scheduler should be solved for at the next frame.
+     *
+     * Only the latest request of a frame is kept.
+     *
+     * @param scheduler The scheduler collecting the request.
+     * @param inputDistance The distance of the root.
+     * @param round Whether distances are rounded to whole units.
+     */
+    constexpr void RequestResize(LinearFrameScheduler& scheduler, const float inputDistance, const bool round) noexcept {
+        scheduler.inputDistance = inputDistance;
+        scheduler.round = round;
+        scheduler.hasInput = true;
+        scheduler.resizePending = true;
+        ++scheduler.pending.resizeRequests;
+    }
+
+    /**
+     * Records the size the root of a rect scheduler should be solved for at the next frame.
+     *
+     * Only the latest request of a frame is kept.
+     *
+     * @param scheduler The scheduler collecting the request.
+     * @param mainInput The main-axis size of the root.
+     * @param crossInput The cross-axis size of the root.
+     * @param round Whether distances are rounded to whole units.
+     */
+    constexpr void RequestResize(RectFrameScheduler& scheduler, const float mainInput, const float crossInput, const bool round) noexcept {
+        scheduler.mainInput = mainInput;
+        scheduler.crossInput = crossInput;
+        scheduler.round = round;
+        scheduler.hasInput = true;
+        scheduler.resizePending = true;
+        ++scheduler.pending.resizeRequests;
+    }
+
+    template<typename SchedulerT>
+    requires FrameScheduler<SchedulerT>
+    /**
+     * Marks a context whose configuration or children changed, to be recomputed at the next frame.
+     *
+     * Unlike `UpdateContextMetrics`, nothing is recomputed now: the context and its
+     * ancestors are recomputed once at the next `FlushFrame`, however many times they
+     * are invalidated. The context must stay alive until then.
+     *
+     * @param scheduler The scheduler collecting the invalidation.
+     * @param ctx The changed context.
+     */
+    void Invalidate(SchedulerT& scheduler, FrameSchedulerContext<SchedulerT>& ctx) {
+        scheduler.dirty.push_back(&ctx);
+        ++scheduler.pending.invalidations;
+    }
+
+    template<typename SchedulerT>
+    requires FrameScheduler<SchedulerT>
+    /**
+     * Links a child context to a parent and defers the metric update to the next frame.
+     *
+     * @param scheduler The scheduler collecting the invalidation.
+     * @param parent The context that will become the parent.
+     * @param child The context to be linked as a child.
+     */
+    void ScheduleLink(SchedulerT& scheduler, FrameSchedulerContext<SchedulerT>& parent, FrameSchedulerContext<SchedulerT>& child) {
+        if (&child == &parent || child.parent == &parent) return;
+
+        if (auto* formerParent = Attach(parent, child)) Invalidate(scheduler, *formerParent);
+        Invalidate(scheduler, parent);
+    }
+
+    template<typename SchedulerT>
+    requires FrameScheduler<SchedulerT>
+    /**
+     * Unlinks a child context from its parent and defers the metric update to the next frame.
+     *
+     * @param scheduler The scheduler collecting the invalidation.
+     * @param child The context to be unlinked from its parent.
+     */
+    void ScheduleUnlink(SchedulerT& scheduler, FrameSchedulerContext<SchedulerT>& child) {
+        if (auto* formerParent = Detach(child)) Invalidate(scheduler, *formerParent);
+    }
+
+    template<typename SchedulerT>
+    requires FrameScheduler<SchedulerT>
+    /**
+     * Runs the work collected since the last frame as one pre-compute, sizing and placing pass.
+     *
+     * Every invalidated context and its ancestors are recomputed exactly once with
+     * `RecomputeDirtyMetrics`, then the root is solved once for the latest requested
+     * size with `ParallelUpdateSegments`, so nodes whose pre-compute picked
+     * `ParallelDescent` size their children concurrently while every other node is
+     * solved as `UpdateSegments` would. A frame with nothing pending does no work. The statistics of the frame are
+     * stored in `lastFrame` and added to `total`; `coalescedRequests` counts the
+     * requests that would each have triggered an `UpdateSegments` of their own.
+     *
+     * @param scheduler The scheduler to flush.
+     * @param workerCount The maximum number of workers for the pre-compute and the solve, or zero for the host default.
+     * @return True if the root was solved this frame.
+     */
+    bool FlushFrame(SchedulerT& scheduler, const size_t workerCount = 0) {
+        SegmentSchedulerStats frame = scheduler.pending;
+        scheduler.pending = {};
+        frame.frames = 1;
+
+        const bool dirty = !scheduler.dirty.empty();
+        if (!dirty && !scheduler.resizePending) {
+            frame.idleFrames = 1;
+            scheduler.lastFrame = frame;
+            AccumulateSchedulerStats(scheduler.total, frame);
+            return false;
+        }
+
+        if (dirty) {
+            frame.recomputedContexts = RecomputeDirtyMetrics(std::span<FrameSchedulerContext<SchedulerT>* const>(scheduler.dirty), workerCount);
+            scheduler.dirty.clear();
+        }
+
+        const bool solve = scheduler.root != nullptr && scheduler.hasInput;
+        if (solve) {
+            if constexpr (std::same_as<SchedulerT, LinearFrameScheduler>) {
+                ParallelUpdateSegments(*scheduler.root, scheduler.inputDistance, scheduler.round, workerCount);
+            }
+            else {
+                ParallelUpdateSegments(*scheduler.root, scheduler.mainInput, scheduler.crossInput, scheduler.round, workerCount);
+            }
+            frame.solves = 1;
+        }
+        scheduler.resizePending = false;
+
+        const uint64_t requests = frame.invalidations + frame.resizeRequests;
+        frame.coalescedRequests = requests > frame.solves ? requests - frame.solves : 0;
+
+        scheduler.lastFrame = frame;
+        AccumulateSchedulerStats(scheduler.total, frame);
+        return solve;
+    }
+
+}
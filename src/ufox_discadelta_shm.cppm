@@ -0,0 +1,307 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#define DISCADELTA_POSIX_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+export module ufox_discadelta_shm;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_export;
+
+export namespace ufox::geometry::discadelta {
+
+#ifdef DISCADELTA_POSIX_SHM
+    inline constexpr uint32_t sharedRectRingMagic = 0x44534452; // "RDSD"
+    inline constexpr uint32_t sharedRectRingVersion = 1;
+    inline constexpr size_t sharedRectRingAlignment = 64;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared rect rings need lock-free 64-bit atomics");
+
+    /**
+     * Rounds a byte size up to the cache-line alignment used inside a shared rect ring.
+     *
+     * @param size The size to align.
+     * @return The aligned size.
+     */
+    [[nodiscard]] constexpr size_t AlignSharedRectRing(const size_t size) noexcept {
+        return (size + sharedRectRingAlignment - 1) & ~(sharedRectRingAlignment - 1);
+    }
+
+    /**
+     * Computes the size of one slot holding up to `capacity` rects.
+     *
+     * A slot is its header followed by the `x`, `y`, `width`, `height`, `nodeId` and
+     * `depth` arrays, each `capacity` elements long, in that order.
+     *
+     * @param capacity The maximum number of rects per frame.
+     * @return The aligned slot size in bytes.
+     */
+    [[nodiscard]] constexpr size_t GetSharedRectSlotStride(const uint32_t capacity) noexcept {
+        return AlignSharedRectRing(AlignSharedRectRing(sizeof(SharedRectSlotHeader)) + size_t{capacity} * (4 * sizeof(float) + sizeof(uint32_t) + sizeof(uint16_t)));
+    }
+
+    /**
+     * Returns the header at the start of a mapped ring.
+     *
+     * @param ring The mapped ring.
+     * @return The ring header, shared with every process mapping the ring.
+     */
+    [[nodiscard]] inline SharedRectRingHeader& GetSharedRectRingHeader(const SharedRectRing& ring) noexcept {
+        return *std::launder(reinterpret_cast<SharedRectRingHeader*>(ring.mapping));
+    }
+
+    /**
+     * Returns the header of the slot used by a given frame sequence.
+     *
+     * @param ring The mapped ring.
+     * @param sequence The frame sequence, starting at 1; frames cycle through the slots.
+     * @return The slot header holding the slot's sequence lock and rect count.
+     */
+    [[nodiscard]] inline SharedRectSlotHeader& GetSharedRectSlotHeader(const SharedRectRing& ring, const uint64_t sequence) noexcept {
+        const SharedRectRingHeader& header = GetSharedRectRingHeader(ring);
+        std::byte* slot = ring.mapping + AlignSharedRectRing(sizeof(SharedRectRingHeader)) + ((sequence - 1) % header.slotCount) * header.slotStride;
+        return *std::launder(reinterpret_cast<SharedRectSlotHeader*>(slot));
+    }
+
+    template<typename T>
+    /**
+     * Locates one of the arrays of the slot used by a given sequence.
+     *
+     * @param ring The mapped ring.
+     * @param sequence The frame sequence selecting the slot.
+     * @param arrayIndex The array position: 0-3 for `x`, `y`, `width`, `height`, 4 for `nodeId`, 5 for `depth`.
+     * @return A pointer to the first element of the array.
+     */
+    [[nodiscard]] T* GetSharedRectSlotArray(const SharedRectRing& ring, const uint64_t sequence, const size_t arrayIndex) noexcept {
+        const size_t capacity = GetSharedRectRingHeader(ring).capacity;
+        auto* data = reinterpret_cast<std::byte*>(&GetSharedRectSlotHeader(ring, sequence)) + AlignSharedRectRing(sizeof(SharedRectSlotHeader));
+        const size_t floatArrays = std::min<size_t>(arrayIndex, 4);
+        const size_t idArrays = arrayIndex > 4 ? 1 : 0;
+        return reinterpret_cast<T*>(data + capacity * (floatArrays * sizeof(float) + idArrays * sizeof(uint32_t)));
+    }
+
+    /**
+     * Unmaps a shared rect ring and, for the creating process, removes its name.
+     *
+     * @param ring The ring to destroy; readers that still map it keep a valid mapping.
+     */
+    void DestroySharedRectRing(SharedRectRing* ring) noexcept {
+        if (!ring) return;
+
+        if (ring->mapping != nullptr) munmap(ring->mapping, ring->mappingSize);
+        if (ring->owner) shm_unlink(ring->name.c_str());
+
+        delete ring;
+    }
+
+    using SharedRectRingHandler = std::unique_ptr<SharedRectRing, decltype(&DestroySharedRectRing)>;
+
+    /**
+     * Creates a named POSIX shared-memory ring that a compositor process can map.
+     *
+     * The ring holds `slotCount` frame slots, each guarded by a sequence lock, so the
+     * writer never blocks and readers never make a syscall per frame. The name follows
+     * `shm_open` rules, e.g. `"/my_ui_rects"`. Creation fails if an object with the name
+     * exists, since a compositor may still be mapping it, unless `replaceExisting` is set;
+     * a replaced object stays valid for processes that already mapped it, but they no
+     * longer see new frames.
+     *
+     * @param createInfo The ring name, slot count (at least two), rect capacity per frame and whether an existing ring is replaced.
+     * @return The writable ring, or a null handler if the name is taken or the shared memory could not be created.
+     */
+    [[nodiscard]] SharedRectRingHandler CreateSharedRectRing(const SharedRectRingCreateInfo& createInfo) noexcept {
+        SharedRectRingHandler handler{nullptr, &DestroySharedRectRing};
+        if (createInfo.slotCount < 2 || createInfo.capacity == 0) return handler;
+
+        const uint64_t slotStride = GetSharedRectSlotStride(createInfo.capacity);
+        const size_t mappingSize = AlignSharedRectRing(sizeof(SharedRectRingHeader)) + createInfo.slotCount * slotStride;
+
+        if (createInfo.replaceExisting) shm_unlink(createInfo.name.c_str());
+        const int fd = shm_open(createInfo.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return handler;
+
+        void* mapping = ftruncate(fd, static_cast<off_t>(mappingSize)) == 0
+            ? mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        close(fd);
+
+        if (mapping == MAP_FAILED) {
+            shm_unlink(createInfo.name.c_str());
+            return handler;
+        }
+
+        auto* ring = new (std::nothrow) SharedRectRing{createInfo.name, static_cast<std::byte*>(mapping), mappingSize, true, 1};
+        if (ring == nullptr) {
+            munmap(mapping, mappingSize);
+            shm_unlink(createInfo.name.c_str());
+            return handler;
+        }
+        handler.reset(ring);
+
+        auto* header = new (mapping) SharedRectRingHeader{};
+        header->slotCount = createInfo.slotCount;
+        header->capacity = createInfo.capacity;
+        header->slotStride = slotStride;
+        for (uint32_t i = 0; i < createInfo.slotCount; ++i) {
+            new (&GetSharedRectSlotHeader(*ring, i + 1)) SharedRectSlotHeader{};
+        }
+        header->version = sharedRectRingVersion;
+        std::atomic_ref(header->magic).store(sharedRectRingMagic, std::memory_order_release);
+
+        return handler;
+    }
+
+    /**
+     * Maps an existing shared rect ring read-only, typically from the compositor process.
+     *
+     * @param name The name the ring was created with.
+     * @return The readable ring, or a null handler if it does not exist or has an unexpected layout.
+     */
+    [[nodiscard]] SharedRectRingHandler OpenSharedRectRing(const std::string& name) noexcept {
+        SharedRectRingHandler handler{nullptr, &DestroySharedRectRing};
+
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return handler;
+
+        struct stat info{};
+        const size_t mappingSize = fstat(fd, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+        void* mapping = mappingSize >= sizeof(SharedRectRingHeader)
+            ? mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        close(fd);
+
+        if (mapping == MAP_FAILED) return handler;
+
+        auto* ring = new (std::nothrow) SharedRectRing{name, static_cast<std::byte*>(mapping), mappingSize, false, 0};
+        if (ring == nullptr) {
+            munmap(mapping, mappingSize);
+            return handler;
+        }
+        handler.reset(ring);
+
+        const SharedRectRingHeader& header = GetSharedRectRingHeader(*ring);
+        const bool valid = std::atomic_ref(const_cast<uint32_t&>(header.magic)).load(std::memory_order_acquire) == sharedRectRingMagic
+            && header.version == sharedRectRingVersion
+            && header.slotCount >= 2
+            && header.slotStride == GetSharedRectSlotStride(header.capacity)
+            && mappingSize >= AlignSharedRectRing(sizeof(SharedRectRingHeader)) + header.slotCount * header.slotStride;
+
+        if (!valid) handler.reset();
+        return handler;
+    }
+
+    /**
+     * Publishes staged rects as the next frame of a shared rect ring.
+     *
+     * The slot's sequence lock is made odd, the arrays are copied, and the lock and
+     * the ring's published sequence are released with the new frame number. At most
+     * `capacity` rects are written; the rest are dropped.
+     *
+     * @param ring A ring returned by `CreateSharedRectRing`.
+     * @param staged The rects to publish, in the order readers should see them.
+     * @return The sequence number of the published frame, or 0 if the ring is not writable.
+     */
+    uint64_t PublishSharedRects(SharedRectRing& ring, const RectExportBuffer& staged) noexcept {
+        if (!ring.owner || ring.mapping == nullptr) return 0;
+
+        SharedRectRingHeader& header = GetSharedRectRingHeader(ring);
+        const uint64_t sequence = ring.nextSequence++;
+        SharedRectSlotHeader& slot = GetSharedRectSlotHeader(ring, sequence);
+        const size_t count = std::min<size_t>(staged.x.size(), header.capacity);
+
+        slot.sequence.store(sequence * 2 - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(GetSharedRectSlotArray<float>(ring, sequence, 0), staged.x.data(), count * sizeof(float));
+        std::memcpy(GetSharedRectSlotArray<float>(ring, sequence, 1), staged.y.data(), count * sizeof(float));
+        std::memcpy(GetSharedRectSlotArray<float>(ring, sequence, 2), staged.width.data(), count * sizeof(float));
+        std::memcpy(GetSharedRectSlotArray<float>(ring, sequence, 3), staged.height.data(), count * sizeof(float));
+        std::memcpy(GetSharedRectSlotArray<uint32_t>(ring, sequence, 4), staged.nodeId.data(), count * sizeof(uint32_t));
+        std::memcpy(GetSharedRectSlotArray<uint16_t>(ring, sequence, 5), staged.depth.data(), count * sizeof(uint16_t));
+        slot.count = static_cast<uint32_t>(count);
+
+        slot.sequence.store(sequence * 2, std::memory_order_release);
+        header.publishedSequence.store(sequence, std::memory_order_release);
+
+        return sequence;
+    }
+
+    /**
+     * Stages the placed rects of a subtree in placement order and publishes them as the next frame.
+     *
+     * @param ring A ring returned by `CreateSharedRectRing`.
+     * @param root The placed root of the subtree to publish.
+     * @param staging A reusable staging buffer, owned by the caller.
+     * @param leavesOnly Whether only leaf contexts are published.
+     * @return The sequence number of the published frame, or 0 if the ring is not writable.
+     */
+    uint64_t PublishSharedRects(SharedRectRing& ring, const RectSegmentContext& root, RectExportBuffer& staging, const bool leavesOnly = false) noexcept {
+        StageRectExport(root, staging, leavesOnly);
+        return PublishSharedRects(ring, staging);
+    }
+
+    /**
+     * Returns the latest complete frame of a shared rect ring as views into the mapping.
+     *
+     * Nothing is copied: the spans point straight into shared memory. Since the writer
+     * may reuse the slot after `slotCount - 1` newer frames, a reader that needs a
+     * consistent frame calls `ValidateSharedRectFrame` once it is done with the data.
+     *
+     * @param ring A ring returned by `OpenSharedRectRing` or `CreateSharedRectRing`.
+     * @param afterSequence Only frames newer than this sequence are returned.
+     * @return The latest frame, or an empty frame with sequence 0 if there is none newer or the slot is being rewritten.
+     */
+    [[nodiscard]] SharedRectFrame AcquireSharedRectFrame(const SharedRectRing& ring, const uint64_t afterSequence = 0) noexcept {
+        if (ring.mapping == nullptr) return {};
+
+        const SharedRectRingHeader& header = GetSharedRectRingHeader(ring);
+        const uint64_t sequence = header.publishedSequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence <= afterSequence) return {};
+
+        const SharedRectSlotHeader& slot = GetSharedRectSlotHeader(ring, sequence);
+        if (slot.sequence.load(std::memory_order_acquire) != sequence * 2) return {};
+
+        const size_t count = std::min<uint32_t>(slot.count, header.capacity);
+        return SharedRectFrame{
+            .sequence = sequence,
+            .x = {GetSharedRectSlotArray<const float>(ring, sequence, 0), count},
+            .y = {GetSharedRectSlotArray<const float>(ring, sequence, 1), count},
+            .width = {GetSharedRectSlotArray<const float>(ring, sequence, 2), count},
+            .height = {GetSharedRectSlotArray<const float>(ring, sequence, 3), count},
+            .nodeId = {GetSharedRectSlotArray<const uint32_t>(ring, sequence, 4), count},
+            .depth = {GetSharedRectSlotArray<const uint16_t>(ring, sequence, 5), count}};
+    }
+
+    /**
+     * Checks that a frame returned by `AcquireSharedRectFrame` was not overwritten while it was read.
+     *
+     * @param ring The ring the frame was acquired from.
+     * @param frame The acquired frame.
+     * @return True if every value read from the frame so far is consistent.
+     */
+    [[nodiscard]] bool ValidateSharedRectFrame(const SharedRectRing& ring, const SharedRectFrame& frame) noexcept {
+        if (ring.mapping == nullptr || frame.sequence == 0) return false;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return GetSharedRectSlotHeader(ring, frame.sequence).sequence.load(std::memory_order_relaxed) == frame.sequence * 2;
+    }
+#endif
+
+}
@@ -0,0 +1,819 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DISCADELTA_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(DISCADELTA_SIMD_SSE2) && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+#define DISCADELTA_SIMD_DISPATCH 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DISCADELTA_TARGET(isa)
+#else
+#define DISCADELTA_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+export module ufox_discadelta_simd;
+
+import ufox_discadelta_lib;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Clamps and truncates a distance into the signed 16-bit instance range.
+     *
+     * @param value The distance to convert.
+     * @return The value truncated toward zero and saturated to `int16_t`.
+     */
+    [[nodiscard]] constexpr int16_t QuantizeSigned(const float value) noexcept {
+        return static_cast<int16_t>(std::min(std::max(value, -32768.0f), 32767.0f));
+    }
+
+    /**
+     * Clamps and truncates a distance into the unsigned 16-bit instance range.
+     *
+     * @param value The distance to convert.
+     * @return The value truncated toward zero and saturated to `uint16_t`.
+     */
+    [[nodiscard]] constexpr uint16_t QuantizeUnsigned(const float value) noexcept {
+        return static_cast<uint16_t>(std::min(std::max(value, 0.0f), 65535.0f));
+    }
+
+    /**
+     * Clamps and truncates a distance into the signed 32-bit integer range.
+     *
+     * The upper bound is the largest float below 2^31, so the conversion never overflows.
+     *
+     * @param value The distance to convert.
+     * @param lowest The lowest accepted value, zero for sizes.
+     * @return The value truncated toward zero and saturated to `int32_t`.
+     */
+    [[nodiscard]] constexpr int32_t TruncateToInt32(const float value, const float lowest) noexcept {
+        return static_cast<int32_t>(std::min(std::max(value, lowest), 2147483520.0f));
+    }
+
+    template<typename RectT>
+    concept Int32RectLayout = std::is_trivially_copyable_v<RectT> && sizeof(RectT) == sizeof(std::array<int32_t, 4>);
+
+    template<typename RectT>
+    requires Int32RectLayout<RectT>
+    /**
+     * Converts staged rect results into 32-bit integer rects, one element at a time.
+     *
+     * The target type must be laid out as `{int32 x, int32 y, uint32 width, uint32 height}`,
+     * like `vk::Rect2D`. Values are truncated toward zero like `MakeVKRect2D`, with
+     * positions saturated to the `int32_t` range and sizes clamped at zero.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param first The first staged element to convert.
+     * @param target The rects receiving elements `[first, first + target.size())`.
+     */
+    void TruncateRectsScalar(const RectExportBuffer& source, const size_t first, const std::span<RectT> target) noexcept {
+        constexpr float lowestPosition = -2147483648.0f;
+
+        for (size_t i = 0; i < target.size(); ++i) {
+            const size_t s = first + i;
+            target[i] = std::bit_cast<RectT>(std::array<int32_t, 4>{
+                TruncateToInt32(source.x[s], lowestPosition),
+                TruncateToInt32(source.y[s], lowestPosition),
+                TruncateToInt32(source.width[s], 0.0f),
+                TruncateToInt32(source.height[s], 0.0f)});
+        }
+    }
+
+    /**
+     * Packs staged rect results into quantized instances, one element at a time.
+     *
+     * Positions saturate to `int16_t` and sizes to `uint16_t`, truncating toward zero
+     * like `MakeVKRect2D`. This is the reference every vectorized kernel must match.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param first The first staged element to convert.
+     * @param target The instances receiving elements `[first, first + target.size())`.
+     */
+    void QuantizeRectInstancesScalar(const RectExportBuffer& source, const size_t first, const std::span<RectInstance> target) noexcept {
+        for (size_t i = 0; i < target.size(); ++i) {
+            const size_t s = first + i;
+            target[i] = RectInstance{
+                .x = QuantizeSigned(source.x[s]),
+                .y = QuantizeSigned(source.y[s]),
+                .width = QuantizeUnsigned(source.width[s]),
+                .height = QuantizeUnsigned(source.height[s]),
+                .depth = source.depth[s],
+                .reserved = 0,
+                .nodeId = source.nodeId[s]};
+        }
+    }
+
+    /**
+     * Blends two float arrays element by element, one element at a time.
+     *
+     * Each output is `from * (1 - t) + to * t`, which returns `from` exactly at zero
+     * and `to` exactly at one.
+     *
+     * @param from The values at `t = 0`.
+     * @param to The values at `t = 1`.
+     * @param t The blend factor.
+     * @param first The first element to blend.
+     * @param target The values receiving elements `[first, first + target.size())`.
+     */
+    void LerpFloatsScalar(const std::span<const float> from, const std::span<const float> to, const float t, const size_t first, const std::span<float> target) noexcept {
+        const float s = 1.0f - t;
+        for (size_t i = 0; i < target.size(); ++i) {
+            target[i] = from[first + i] * s + to[first + i] * t;
+        }
+    }
+
+    /**
+     * Scales a float array and clamps every element to its own bounds, one element at a time.
+     *
+     * Each output is `min(max(value * scale, lower), upper)`, the proportional share of a
+     * segment clamped to its minimum and maximum.
+     *
+     * @param values The values to scale.
+     * @param scale The common scale factor.
+     * @param lower The lower bound of every element.
+     * @param upper The upper bound of every element.
+     * @param first The first element to scale.
+     * @param target The values receiving elements `[first, first + target.size())`.
+     */
+    void ScaleClampFloatsScalar(const std::span<const float> values, const float scale, const std::span<const float> lower, const std::span<const float> upper, const size_t first, const std::span<float> target) noexcept {
+        for (size_t i = 0; i < target.size(); ++i) {
+            const size_t s = first + i;
+            target[i] = std::min(std::max(values[s] * scale, lower[s]), upper[s]);
+        }
+    }
+
+    /**
+     * Rounds a float array to whole units, halves away from zero, one element at a time.
+     *
+     * This is the rounding the solver applies with `std::lroundf`, kept in float.
+     *
+     * @param values The values to round.
+     * @param first The first element to round.
+     * @param target The values receiving elements `[first, first + target.size())`.
+     */
+    void RoundFloatsScalar(const std::span<const float> values, const size_t first, const std::span<float> target) noexcept {
+        for (size_t i = 0; i < target.size(); ++i) {
+            target[i] = std::round(values[first + i]);
+        }
+    }
+
+#ifdef DISCADELTA_SIMD_SSE2
+    /**
+     * Packs staged rect results into quantized instances four elements at a time with SSE2.
+     *
+     * Lanes are clamped in float, truncated to 32-bit integers and narrowed with signed
+     * saturation; sizes are biased by 32768 around the narrowing so the signed pack
+     * covers the full unsigned range. The four 16-byte instances are then assembled with
+     * unpacks and written unaligned. Any tail shorter than four runs the scalar kernel.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The instances receiving the first `target.size()` staged elements.
+     */
+    void QuantizeRectInstancesSSE2(const RectExportBuffer& source, const std::span<RectInstance> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 signedMin = _mm_set1_ps(-32768.0f);
+        const __m128 signedMax = _mm_set1_ps(32767.0f);
+        const __m128 unsignedMax = _mm_set1_ps(65535.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128i bias = _mm_set1_epi32(32768);
+        const __m128i unbias = _mm_set1_epi16(static_cast<short>(0x8000));
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128i x = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.x[i]), signedMin), signedMax));
+            const __m128i y = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.y[i]), signedMin), signedMax));
+            const __m128i w = _mm_sub_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.width[i]), zero), unsignedMax)), bias);
+            const __m128i h = _mm_sub_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.height[i]), zero), unsignedMax)), bias);
+
+            // x0..x3 | y0..y3 and w0..w3 | h0..h3 as 16-bit lanes
+            const __m128i xy16 = _mm_packs_epi32(x, y);
+            const __m128i wh16 = _mm_xor_si128(_mm_packs_epi32(w, h), unbias);
+
+            // x0 y0 x1 y1 ... and w0 h0 w1 h1 ...
+            const __m128i xy = _mm_unpacklo_epi16(xy16, _mm_srli_si128(xy16, 8));
+            const __m128i wh = _mm_unpacklo_epi16(wh16, _mm_srli_si128(wh16, 8));
+
+            const __m128i xywh01 = _mm_unpacklo_epi32(xy, wh);
+            const __m128i xywh23 = _mm_unpackhi_epi32(xy, wh);
+
+            const __m128i depth = _mm_set_epi32(source.depth[i + 3], source.depth[i + 2], source.depth[i + 1], source.depth[i]);
+            const __m128i id = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source.nodeId[i]));
+            const __m128i tail01 = _mm_unpacklo_epi32(depth, id);
+            const __m128i tail23 = _mm_unpackhi_epi32(depth, id);
+
+            auto* out = reinterpret_cast<__m128i*>(&target[i]);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi64(xywh01, tail01));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi64(xywh01, tail01));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi64(xywh23, tail23));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi64(xywh23, tail23));
+        }
+
+        QuantizeRectInstancesScalar(source, vectorCount, target.subspan(vectorCount));
+    }
+
+    template<typename RectT>
+    requires Int32RectLayout<RectT>
+    /**
+     * Converts staged rect results into 32-bit integer rects four elements at a time with SSE2.
+     *
+     * Each block of four is clamped, truncated and transposed from structure-of-arrays
+     * lanes into four `{x, y, width, height}` records. Any tail shorter than four runs
+     * the scalar kernel.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The rects receiving the first `target.size()` staged elements.
+     */
+    void TruncateRectsSSE2(const RectExportBuffer& source, const std::span<RectT> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 positionMin = _mm_set1_ps(-2147483648.0f);
+        const __m128 valueMax = _mm_set1_ps(2147483520.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128i x = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.x[i]), positionMin), valueMax));
+            const __m128i y = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.y[i]), positionMin), valueMax));
+            const __m128i w = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.width[i]), zero), valueMax));
+            const __m128i h = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.height[i]), zero), valueMax));
+
+            const __m128i xy01 = _mm_unpacklo_epi32(x, y);
+            const __m128i wh01 = _mm_unpacklo_epi32(w, h);
+            const __m128i xy23 = _mm_unpackhi_epi32(x, y);
+            const __m128i wh23 = _mm_unpackhi_epi32(w, h);
+
+            auto* out = reinterpret_cast<__m128i*>(&target[i]);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi64(xy01, wh01));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi64(xy01, wh01));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi64(xy23, wh23));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi64(xy23, wh23));
+        }
+
+        TruncateRectsScalar(source, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Blends two float arrays four elements at a time with SSE2.
+     *
+     * Uses the same operation order as `LerpFloatsScalar`, so both kernels agree
+     * unless the compiler contracts the scalar form into fused multiply-adds. Any
+     * tail shorter than four runs the scalar kernel.
+     *
+     * @param from The values at `t = 0`.
+     * @param to The values at `t = 1`.
+     * @param t The blend factor.
+     * @param target The values receiving the first `target.size()` blended elements.
+     */
+    void LerpFloatsSSE2(const std::span<const float> from, const std::span<const float> to, const float t, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 weightTo = _mm_set1_ps(t);
+        const __m128 weightFrom = _mm_set1_ps(1.0f - t);
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128 a = _mm_mul_ps(_mm_loadu_ps(&from[i]), weightFrom);
+            const __m128 b = _mm_mul_ps(_mm_loadu_ps(&to[i]), weightTo);
+            _mm_storeu_ps(&target[i], _mm_add_ps(a, b));
+        }
+
+        LerpFloatsScalar(from, to, t, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Scales and clamps a float array four elements at a time with SSE2.
+     *
+     * Matches `ScaleClampFloatsScalar` bit for bit, NaN and signed zeros included: the
+     * SSE min and max return their second operand when the comparison fails, which is
+     * what `std::max(scaled, lower)` and `std::min(clamped, upper)` return, so the bounds
+     * go first. Any tail shorter than four runs the scalar kernel.
+     *
+     * @param values The values to scale.
+     * @param scale The common scale factor.
+     * @param lower The lower bound of every element.
+     * @param upper The upper bound of every element.
+     * @param target The values receiving the first `target.size()` scaled elements.
+     */
+    void ScaleClampFloatsSSE2(const std::span<const float> values, const float scale, const std::span<const float> lower, const std::span<const float> upper, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 factor = _mm_set1_ps(scale);
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(&values[i]), factor);
+            _mm_storeu_ps(&target[i], _mm_min_ps(_mm_loadu_ps(&upper[i]), _mm_max_ps(_mm_loadu_ps(&lower[i]), scaled)));
+        }
+
+        ScaleClampFloatsScalar(values, scale, lower, upper, vectorCount, target.subspan(vectorCount));
+    }
+#endif
+
+#ifdef DISCADELTA_SIMD_DISPATCH
+    /**
+     * Packs staged rect results into quantized instances four elements at a time with SSE4.1.
+     *
+     * Same as `QuantizeRectInstancesSSE2`, except that sizes are narrowed with the
+     * unsigned saturating pack directly instead of being biased around a signed one.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The instances receiving the first `target.size()` staged elements.
+     */
+    DISCADELTA_TARGET("sse4.1") void QuantizeRectInstancesSSE41(const RectExportBuffer& source, const std::span<RectInstance> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 signedMin = _mm_set1_ps(-32768.0f);
+        const __m128 signedMax = _mm_set1_ps(32767.0f);
+        const __m128 unsignedMax = _mm_set1_ps(65535.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128i x = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.x[i]), signedMin), signedMax));
+            const __m128i y = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.y[i]), signedMin), signedMax));
+            const __m128i w = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.width[i]), zero), unsignedMax));
+            const __m128i h = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.height[i]), zero), unsignedMax));
+
+            const __m128i xy16 = _mm_packs_epi32(x, y);
+            const __m128i wh16 = _mm_packus_epi32(w, h);
+
+            const __m128i xy = _mm_unpacklo_epi16(xy16, _mm_srli_si128(xy16, 8));
+            const __m128i wh = _mm_unpacklo_epi16(wh16, _mm_srli_si128(wh16, 8));
+
+            const __m128i xywh01 = _mm_unpacklo_epi32(xy, wh);
+            const __m128i xywh23 = _mm_unpackhi_epi32(xy, wh);
+
+            const __m128i depth = _mm_set_epi32(source.depth[i + 3], source.depth[i + 2], source.depth[i + 1], source.depth[i]);
+            const __m128i id = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source.nodeId[i]));
+            const __m128i tail01 = _mm_unpacklo_epi32(depth, id);
+            const __m128i tail23 = _mm_unpackhi_epi32(depth, id);
+
+            auto* out = reinterpret_cast<__m128i*>(&target[i]);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi64(xywh01, tail01));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi64(xywh01, tail01));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi64(xywh23, tail23));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi64(xywh23, tail23));
+        }
+
+        QuantizeRectInstancesScalar(source, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Rounds a float array four elements at a time with SSE4.1.
+     *
+     * Adds the largest float below one half with the sign of each value, then truncates,
+     * which rounds halves away from zero exactly like `RoundFloatsScalar`.
+     *
+     * @param values The values to round.
+     * @param target The values receiving the first `target.size()` rounded elements.
+     */
+    DISCADELTA_TARGET("sse4.1") void RoundFloatsSSE41(const std::span<const float> values, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{3};
+
+        const __m128 half = _mm_set1_ps(0x1.fffffep-2f);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+
+        for (size_t i = 0; i < vectorCount; i += 4) {
+            const __m128 v = _mm_loadu_ps(&values[i]);
+            const __m128 biased = _mm_add_ps(v, _mm_or_ps(_mm_and_ps(v, sign), half));
+            _mm_storeu_ps(&target[i], _mm_round_ps(biased, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+        }
+
+        RoundFloatsScalar(values, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Blends two float arrays eight elements at a time with AVX2.
+     *
+     * @param from The values at `t = 0`.
+     * @param to The values at `t = 1`.
+     * @param t The blend factor.
+     * @param target The values receiving the first `target.size()` blended elements.
+     */
+    DISCADELTA_TARGET("avx2") void LerpFloatsAVX2(const std::span<const float> from, const std::span<const float> to, const float t, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{7};
+
+        const __m256 weightTo = _mm256_set1_ps(t);
+        const __m256 weightFrom = _mm256_set1_ps(1.0f - t);
+
+        for (size_t i = 0; i < vectorCount; i += 8) {
+            const __m256 a = _mm256_mul_ps(_mm256_loadu_ps(&from[i]), weightFrom);
+            const __m256 b = _mm256_mul_ps(_mm256_loadu_ps(&to[i]), weightTo);
+            _mm256_storeu_ps(&target[i], _mm256_add_ps(a, b));
+        }
+
+        LerpFloatsScalar(from, to, t, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Scales and clamps a float array eight elements at a time with AVX2, like `ScaleClampFloatsSSE2`.
+     *
+     * @param values The values to scale.
+     * @param scale The common scale factor.
+     * @param lower The lower bound of every element.
+     * @param upper The upper bound of every element.
+     * @param target The values receiving the first `target.size()` scaled elements.
+     */
+    DISCADELTA_TARGET("avx2") void ScaleClampFloatsAVX2(const std::span<const float> values, const float scale, const std::span<const float> lower, const std::span<const float> upper, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{7};
+
+        const __m256 factor = _mm256_set1_ps(scale);
+
+        for (size_t i = 0; i < vectorCount; i += 8) {
+            const __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(&values[i]), factor);
+            _mm256_storeu_ps(&target[i], _mm256_min_ps(_mm256_loadu_ps(&upper[i]), _mm256_max_ps(_mm256_loadu_ps(&lower[i]), scaled)));
+        }
+
+        ScaleClampFloatsScalar(values, scale, lower, upper, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Rounds a float array eight elements at a time with AVX2, like `RoundFloatsSSE41`.
+     *
+     * @param values The values to round.
+     * @param target The values receiving the first `target.size()` rounded elements.
+     */
+    DISCADELTA_TARGET("avx2") void RoundFloatsAVX2(const std::span<const float> values, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{7};
+
+        const __m256 half = _mm256_set1_ps(0x1.fffffep-2f);
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+
+        for (size_t i = 0; i < vectorCount; i += 8) {
+            const __m256 v = _mm256_loadu_ps(&values[i]);
+            const __m256 biased = _mm256_add_ps(v, _mm256_or_ps(_mm256_and_ps(v, sign), half));
+            _mm256_storeu_ps(&target[i], _mm256_round_ps(biased, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+        }
+
+        RoundFloatsScalar(values, vectorCount, target.subspan(vectorCount));
+    }
+
+    template<typename RectT>
+    requires Int32RectLayout<RectT>
+    /**
+     * Converts staged rect results into 32-bit integer rects eight elements at a time with AVX2.
+     *
+     * Like `TruncateRectsSSE2`, with a final cross-lane permute putting the eight records
+     * produced by the in-lane unpacks back in order.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The rects receiving the first `target.size()` staged elements.
+     */
+    DISCADELTA_TARGET("avx2") void TruncateRectsAVX2(const RectExportBuffer& source, const std::span<RectT> target) noexcept {
+        const size_t count = target.size();
+        const size_t vectorCount = count & ~size_t{7};
+
+        const __m256 positionMin = _mm256_set1_ps(-2147483648.0f);
+        const __m256 valueMax = _mm256_set1_ps(2147483520.0f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (size_t i = 0; i < vectorCount; i += 8) {
+            const __m256i x = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&source.x[i]), positionMin), valueMax));
+            const __m256i y = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&source.y[i]), positionMin), valueMax));
+            const __m256i w = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&source.width[i]), zero), valueMax));
+            const __m256i h = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&source.height[i]), zero), valueMax));
+
+            // records 0|4, 1|5, 2|6 and 3|7 in the low|high halves
+            const __m256i xyLow = _mm256_unpacklo_epi32(x, y);
+            const __m256i whLow = _mm256_unpacklo_epi32(w, h);
+            const __m256i xyHigh = _mm256_unpackhi_epi32(x, y);
+            const __m256i whHigh = _mm256_unpackhi_epi32(w, h);
+            const __m256i r04 = _mm256_unpacklo_epi64(xyLow, whLow);
+            const __m256i r15 = _mm256_unpackhi_epi64(xyLow, whLow);
+            const __m256i r26 = _mm256_unpacklo_epi64(xyHigh, whHigh);
+            const __m256i r37 = _mm256_unpackhi_epi64(xyHigh, whHigh);
+
+            auto* out = reinterpret_cast<__m256i*>(&target[i]);
+            _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(r04, r15, 0x20));
+            _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(r26, r37, 0x20));
+            _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(r04, r15, 0x31));
+            _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(r26, r37, 0x31));
+        }
+
+        TruncateRectsScalar(source, vectorCount, target.subspan(vectorCount));
+    }
+
+    /**
+     * Returns the AVX-512 lane mask covering the elements left from a given one.
+     *
+     * @param count The number of elements.
+     * @param first The first element of the block.
+     * @return All sixteen lanes, or the lanes of the remaining tail.
+     */
+    [[nodiscard]] constexpr uint16_t TailMask16(const size_t count, const size_t first) noexcept {
+        return count - first >= 16 ? uint16_t{0xFFFF} : static_cast<uint16_t>((1u << (count - first)) - 1u);
+    }
+
+    /**
+     * Blends two float arrays sixteen elements at a time with AVX-512.
+     *
+     * The tail is handled with masked loads and stores. AVX-512F implies FMA, so the
+     * sum is taken with the explicit-rounding add, which the compiler does not contract
+     * with the products; this keeps the result identical to the narrower kernels.
+     *
+     * @param from The values at `t = 0`.
+     * @param to The values at `t = 1`.
+     * @param t The blend factor.
+     * @param target The values receiving the first `target.size()` blended elements.
+     */
+    DISCADELTA_TARGET("avx512f") void LerpFloatsAVX512(const std::span<const float> from, const std::span<const float> to, const float t, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+
+        const __m512 weightTo = _mm512_set1_ps(t);
+        const __m512 weightFrom = _mm512_set1_ps(1.0f - t);
+
+        for (size_t i = 0; i < count; i += 16) {
+            const __mmask16 mask = TailMask16(count, i);
+            const __m512 a = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, &from[i]), weightFrom);
+            const __m512 b = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, &to[i]), weightTo);
+            _mm512_mask_storeu_ps(&target[i], mask, _mm512_add_round_ps(a, b, _MM_FROUND_CUR_DIRECTION));
+        }
+    }
+
+    /**
+     * Scales and clamps a float array sixteen elements at a time with AVX-512, like `ScaleClampFloatsSSE2`.
+     *
+     * @param values The values to scale.
+     * @param scale The common scale factor.
+     * @param lower The lower bound of every element.
+     * @param upper The upper bound of every element.
+     * @param target The values receiving the first `target.size()` scaled elements.
+     */
+    DISCADELTA_TARGET("avx512f") void ScaleClampFloatsAVX512(const std::span<const float> values, const float scale, const std::span<const float> lower, const std::span<const float> upper, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+
+        const __m512 factor = _mm512_set1_ps(scale);
+
+        for (size_t i = 0; i < count; i += 16) {
+            const __mmask16 mask = TailMask16(count, i);
+            const __m512 scaled = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, &values[i]), factor);
+            const __m512 clamped = _mm512_min_ps(_mm512_maskz_loadu_ps(mask, &upper[i]), _mm512_max_ps(_mm512_maskz_loadu_ps(mask, &lower[i]), scaled));
+            _mm512_mask_storeu_ps(&target[i], mask, clamped);
+        }
+    }
+
+    /**
+     * Rounds a float array sixteen elements at a time with AVX-512, like `RoundFloatsSSE41`.
+     *
+     * The sign is transferred with integer operations, which AVX-512F provides for
+     * 512-bit registers where the float ones need AVX-512DQ.
+     *
+     * @param values The values to round.
+     * @param target The values receiving the first `target.size()` rounded elements.
+     */
+    DISCADELTA_TARGET("avx512f") void RoundFloatsAVX512(const std::span<const float> values, const std::span<float> target) noexcept {
+        const size_t count = target.size();
+
+        const __m512i half = _mm512_set1_epi32(static_cast<int>(std::bit_cast<uint32_t>(0x1.fffffep-2f)));
+        const __m512i sign = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+
+        for (size_t i = 0; i < count; i += 16) {
+            const __mmask16 mask = TailMask16(count, i);
+            const __m512 v = _mm512_maskz_loadu_ps(mask, &values[i]);
+            const __m512 bias = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(v), sign), half));
+            _mm512_mask_storeu_ps(&target[i], mask, _mm512_roundscale_ps(_mm512_add_ps(v, bias), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+        }
+    }
+#endif
+
+    /**
+     * Queries the instruction sets of the host, once.
+     *
+     * Uses CPUID, including the operating system's support for the wider registers, on
+     * x86-64 builds with GCC, Clang or MSVC. Other builds report the level the binary
+     * was compiled for, SSE2 or scalar.
+     *
+     * @return The highest level the host can run.
+     */
+    [[nodiscard]] inline SimdLevel DetectSimdLevel() noexcept {
+        static const SimdLevel detected = [] {
+#if defined(DISCADELTA_SIMD_DISPATCH) && defined(_MSC_VER) && !defined(__clang__)
+            std::array<int, 4> info{};
+            __cpuid(info.data(), 0);
+            const int maxLeaf = info[0];
+
+            __cpuid(info.data(), 1);
+            const bool sse41 = (info[2] & (1 << 19)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            const bool ymmState = (xcr0 & 0x6) == 0x6;
+            const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+            bool avx2 = false;
+            bool avx512 = false;
+            if (maxLeaf >= 7) {
+                __cpuidex(info.data(), 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+                avx512 = (info[1] & (1 << 16)) != 0;
+            }
+
+            if (avx512 && avx2 && avx && zmmState) return SimdLevel::AVX512;
+            if (avx2 && avx && ymmState) return SimdLevel::AVX2;
+            if (sse41) return SimdLevel::SSE41;
+            return SimdLevel::SSE2;
+#elif defined(DISCADELTA_SIMD_DISPATCH)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+            if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+            return SimdLevel::SSE2;
+#elif defined(DISCADELTA_SIMD_SSE2)
+            return SimdLevel::SSE2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }();
+        return detected;
+    }
+
+    /**
+     * Parses a SIMD level name: `scalar`, `sse2`, `sse4.1`, `avx2` or `avx512`.
+     *
+     * @param name The name to parse.
+     * @return The named level, or nothing if the name is unknown.
+     */
+    [[nodiscard]] constexpr std::optional<SimdLevel> ParseSimdLevel(const std::string_view name) noexcept {
+        if (name == "scalar") return SimdLevel::Scalar;
+        if (name == "sse2") return SimdLevel::SSE2;
+        if (name == "sse4.1") return SimdLevel::SSE41;
+        if (name == "avx2") return SimdLevel::AVX2;
+        if (name == "avx512") return SimdLevel::AVX512;
+        return std::nullopt;
+    }
+
+    /**
+     * Returns the storage of the level the kernels dispatch to.
+     *
+     * It starts at the detected level, lowered by the `DISCADELTA_SIMD_LEVEL`
+     * environment variable when it names a lower one. A name that is not a level
+     * keeps the detected one.
+     *
+     * @return The active level.
+     */
+    [[nodiscard]] inline std::atomic<SimdLevel>& ActiveSimdLevel() noexcept {
+        static std::atomic<SimdLevel> level = [] {
+            const char* forced = std::getenv("DISCADELTA_SIMD_LEVEL");
+            const std::optional<SimdLevel> parsed = forced != nullptr ? ParseSimdLevel(forced) : std::nullopt;
+            return parsed ? std::min(*parsed, DetectSimdLevel()) : DetectSimdLevel();
+        }();
+        return level;
+    }
+
+    /**
+     * Returns the level the dispatching kernels currently use.
+     *
+     * @return The active level.
+     */
+    [[nodiscard]] inline SimdLevel GetSimdLevel() noexcept {
+        return ActiveSimdLevel().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Forces the dispatching kernels down to a given level, for testing and comparisons.
+     *
+     * A level above what the host supports is lowered to the detected one, so a forced
+     * level is always safe to run. Forcing the detected level restores the default.
+     *
+     * @param level The requested level.
+     * @return The level now in use.
+     */
+    inline SimdLevel ForceSimdLevel(const SimdLevel level) noexcept {
+        const SimdLevel effective = std::min(level, DetectSimdLevel());
+        ActiveSimdLevel().store(effective, std::memory_order_relaxed);
+        return effective;
+    }
+
+    /**
+     * Packs staged rect results into quantized instances with the best available kernel.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The instances receiving the first `target.size()` staged elements.
+     */
+    void QuantizeRectInstances(const RectExportBuffer& source, const std::span<RectInstance> target) noexcept {
+        switch (GetSimdLevel()) {
+#ifdef DISCADELTA_SIMD_DISPATCH
+            case SimdLevel::AVX512:
+            case SimdLevel::AVX2:
+            case SimdLevel::SSE41: QuantizeRectInstancesSSE41(source, target); return;
+#endif
+#ifdef DISCADELTA_SIMD_SSE2
+            case SimdLevel::SSE2: QuantizeRectInstancesSSE2(source, target); return;
+#endif
+            default: QuantizeRectInstancesScalar(source, 0, target); return;
+        }
+    }
+
+    /**
+     * Blends two float arrays with the best available kernel.
+     *
+     * @param from The values at `t = 0`.
+     * @param to The values at `t = 1`.
+     * @param t The blend factor.
+     * @param target The values receiving the first `target.size()` blended elements.
+     */
+    void LerpFloats(const std::span<const float> from, const std::span<const float> to, const float t, const std::span<float> target) noexcept {
+        switch (GetSimdLevel()) {
+#ifdef DISCADELTA_SIMD_DISPATCH
+            case SimdLevel::AVX512: LerpFloatsAVX512(from, to, t, target); return;
+            case SimdLevel::AVX2: LerpFloatsAVX2(from, to, t, target); return;
+#endif
+#ifdef DISCADELTA_SIMD_SSE2
+            case SimdLevel::SSE41:
+            case SimdLevel::SSE2: LerpFloatsSSE2(from, to, t, target); return;
+#endif
+            default: LerpFloatsScalar(from, to, t, 0, target); return;
+        }
+    }
+
+    /**
+     * Scales and clamps a float array with the best available kernel.
+     *
+     * Every level gives the same bits as `ScaleClampFloatsScalar`. The values may be
+     * the target itself, to clamp in place.
+     *
+     * @param values The values to scale.
+     * @param scale The common scale factor.
+     * @param lower The lower bound of every element.
+     * @param upper The upper bound of every element.
+     * @param target The values receiving the first `target.size()` scaled elements.
+     */
+    void ScaleClampFloats(const std::span<const float> values, const float scale, const std::span<const float> lower, const std::span<const float> upper, const std::span<float> target) noexcept {
+        switch (GetSimdLevel()) {
+#ifdef DISCADELTA_SIMD_DISPATCH
+            case SimdLevel::AVX512: ScaleClampFloatsAVX512(values, scale, lower, upper, target); return;
+            case SimdLevel::AVX2: ScaleClampFloatsAVX2(values, scale, lower, upper, target); return;
+#endif
+#ifdef DISCADELTA_SIMD_SSE2
+            case SimdLevel::SSE41:
+            case SimdLevel::SSE2: ScaleClampFloatsSSE2(values, scale, lower, upper, target); return;
+#endif
+            default: ScaleClampFloatsScalar(values, scale, lower, upper, 0, target); return;
+        }
+    }
+
+    /**
+     * Rounds a float array to whole units with the best available kernel.
+     *
+     * Every level gives the same bits as `RoundFloatsScalar`.
+     *
+     * @param values The values to round.
+     * @param target The values receiving the first `target.size()` rounded elements.
+     */
+    void RoundFloats(const std::span<const float> values, const std::span<float> target) noexcept {
+        switch (GetSimdLevel()) {
+#ifdef DISCADELTA_SIMD_DISPATCH
+            case SimdLevel::AVX512: RoundFloatsAVX512(values, target); return;
+            case SimdLevel::AVX2: RoundFloatsAVX2(values, target); return;
+            case SimdLevel::SSE41: RoundFloatsSSE41(values, target); return;
+#endif
+            default: RoundFloatsScalar(values, 0, target); return;
+        }
+    }
+
+    template<typename RectT>
+    requires Int32RectLayout<RectT>
+    /**
+     * Converts staged rect results into 32-bit integer rects with the best available kernel.
+     *
+     * @param source The staged structure-of-arrays rect results.
+     * @param target The rects receiving the first `target.size()` staged elements.
+     */
+    void TruncateRects(const RectExportBuffer& source, const std::span<RectT> target) noexcept {
+        switch (GetSimdLevel()) {
+#ifdef DISCADELTA_SIMD_DISPATCH
+            case SimdLevel::AVX512:
+            case SimdLevel::AVX2: TruncateRectsAVX2(source, target); return;
+#endif
+#ifdef DISCADELTA_SIMD_SSE2
+            case SimdLevel::SSE41:
+            case SimdLevel::SSE2: TruncateRectsSSE2(source, target); return;
+#endif
+            default: TruncateRectsScalar(source, 0, target); return;
+        }
+    }
+
+}
@@ -0,0 +1,323 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+export module ufox_discadelta_stream;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_core;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Number of low float bits dropped when bucketing a clamp threshold.
+     *
+     * Thresholds are non-negative floats, whose bit patterns sort like their values, so
+     * keeping the top bits gives monotone buckets about 0.2% wide across the whole float
+     * range. The histogram therefore has a fixed size, independent of the segment count.
+     */
+    inline constexpr uint32_t segmentStreamBucketShift = 14;
+    inline constexpr size_t segmentStreamBucketCount = (std::bit_cast<uint32_t>(std::numeric_limits<float>::infinity()) >> segmentStreamBucketShift) + 1;
+
+    /**
+     * Maps a non-negative clamp threshold to its histogram bucket.
+     *
+     * @param threshold The threshold, clamped to zero when negative.
+     * @return The index of the bucket holding the threshold.
+     */
+    [[nodiscard]] constexpr size_t GetSegmentStreamBucket(const float threshold) noexcept {
+        return std::bit_cast<uint32_t>(ChooseGreaterDistance(0.0f, threshold)) >> segmentStreamBucketShift;
+    }
+
+    /**
+     * Adds one segment with a threshold to a histogram bucket.
+     *
+     * @param bucket The bucket receiving the segment.
+     * @param threshold The segment's clamp threshold.
+     * @param bound The segment's value while it is clamped.
+     * @param free The constant part of the segment's value while it is not clamped.
+     * @param slope The segment's share per unit of scale while it is not clamped.
+     */
+    constexpr void AddSegmentStreamThreshold(SegmentStreamBucket& bucket, const float threshold, const float bound, const float free, const float slope) noexcept {
+        bucket.lowestThreshold = bucket.count == 0 ? threshold : std::min(bucket.lowestThreshold, threshold);
+        bucket.highestThreshold = bucket.count == 0 ? threshold : std::max(bucket.highestThreshold, threshold);
+        bucket.boundSum += bound;
+        bucket.freeSum += free;
+        bucket.slopeSum += slope;
+        ++bucket.count;
+    }
+
+    /**
+     * Validates a streamed record exactly like a childless linear segment.
+     *
+     * @param record The raw record.
+     * @return The validated min, max, base, compress capacity, compress solidify and expand ratio.
+     */
+    [[nodiscard]] constexpr std::tuple<float, float, float, float, float, float> ValidateSegmentStreamRecord(const SegmentStreamRecord& record) noexcept {
+        const float validatedMin = ChooseGreaterDistance(0.0f, record.min);
+        const float validatedMax = ChooseGreaterDistance(0.0f, validatedMin, record.max);
+        const float validatedBase = std::clamp(ChooseGreaterDistance(0.0f, record.base), validatedMin, validatedMax);
+        const float compressCapacity = validatedBase * ChooseGreaterDistance(0.0f, record.flexCompress);
+        const float compressSolidify = ChooseGreaterDistance(0.0f, validatedBase - compressCapacity);
+        const float expandRatio = ChooseGreaterDistance(0.0f, record.flexExpand);
+
+        return std::make_tuple(validatedMin, validatedMax, validatedBase, compressCapacity, compressSolidify, expandRatio);
+    }
+
+    /**
+     * Resets a stream accumulator before a new first pass.
+     *
+     * @param accumulator The accumulator to reset; its histograms keep their fixed size.
+     */
+    void ResetSegmentStream(SegmentStreamAccumulator& accumulator) {
+        accumulator.segmentCount = 0;
+        accumulator.accumulatedBase = 0.0;
+        accumulator.accumulatedMin = 0.0;
+        accumulator.accumulatedCompressSolidify = 0.0;
+        accumulator.accumulatedExpandRatio = 0.0;
+        accumulator.fixedCompressDistance = 0.0;
+        accumulator.compressThresholds.assign(segmentStreamBucketCount, SegmentStreamBucket{});
+        accumulator.expandThresholds.assign(segmentStreamBucketCount, SegmentStreamBucket{});
+    }
+
+    /**
+     * First pass: folds a chunk of records into the accumulators and clamp-threshold histograms.
+     *
+     * For compression, a segment receives `max(min, solidify + capacity * scale)`, so it is
+     * clamped to its minimum while the scale is below `(min - solidify) / capacity`. For
+     * expansion, it receives `base + min(ratio * scale, max - base)`, so it saturates once
+     * the scale is above `(max - base) / ratio`. Both thresholds are bucketed here.
+     *
+     * @param accumulator The accumulator, reset with `ResetSegmentStream` before the first chunk.
+     * @param records The next chunk of records, in stream order.
+     */
+    void AccumulateSegmentStream(SegmentStreamAccumulator& accumulator, const std::span<const SegmentStreamRecord> records) noexcept {
+        for (const SegmentStreamRecord& record : records) {
+            const auto [validatedMin, validatedMax, validatedBase, compressCapacity, compressSolidify, expandRatio] = ValidateSegmentStreamRecord(record);
+
+            accumulator.accumulatedBase += validatedBase;
+            accumulator.accumulatedMin += ChooseGreaterDistance(validatedMin, compressSolidify);
+            accumulator.accumulatedCompressSolidify += compressSolidify;
+            accumulator.accumulatedExpandRatio += expandRatio;
+
+            if (compressCapacity > 0.0f) {
+                const float threshold = ChooseGreaterDistance(0.0f, (validatedMin - compressSolidify) / compressCapacity);
+                AddSegmentStreamThreshold(accumulator.compressThresholds[GetSegmentStreamBucket(threshold)], threshold, validatedMin, compressSolidify, compressCapacity);
+            }
+            else {
+                accumulator.fixedCompressDistance += ChooseGreaterDistance(validatedMin, compressSolidify);
+            }
+
+            if (expandRatio > 0.0f) {
+                const float maxDelta = ChooseGreaterDistance(0.0f, validatedMax - validatedBase);
+                const float threshold = maxDelta / expandRatio;
+                AddSegmentStreamThreshold(accumulator.expandThresholds[GetSegmentStreamBucket(threshold)], threshold, maxDelta, 0.0f, expandRatio);
+            }
+        }
+
+        accumulator.segmentCount += records.size();
+    }
+
+    /**
+     * Finds the compression scale distributing a target distance, from the threshold histogram.
+     *
+     * Between buckets the total is linear in the scale and is solved exactly; only when the
+     * target falls inside one bucket's threshold range is the scale interpolated across it.
+     *
+     * @param buckets The compression threshold histogram.
+     * @param target The distance to distribute over the segments that have a capacity.
+     * @return The compression scale.
+     */
+    [[nodiscard]] double ResolveCompressScale(const std::span<const SegmentStreamBucket> buckets, const double target) noexcept {
+        double boundAbove = 0.0;
+        for (const auto& bucket : buckets) boundAbove += bucket.boundSum;
+
+        double freeBelow = 0.0;
+        double slopeBelow = 0.0;
+
+        for (const auto& bucket : buckets) {
+            if (bucket.count == 0) continue;
+
+            const double lowest = bucket.lowestThreshold;
+            const double totalAtLowest = freeBelow + slopeBelow * lowest + boundAbove;
+            if (totalAtLowest >= target) {
+                return slopeBelow > 0.0 ? (target - freeBelow - boundAbove) / slopeBelow : lowest;
+            }
+
+            boundAbove -= bucket.boundSum;
+            freeBelow += bucket.freeSum;
+            slopeBelow += bucket.slopeSum;
+
+            const double highest = bucket.highestThreshold;
+            const double totalAtHighest = freeBelow + slopeBelow * highest + boundAbove;
+            if (totalAtHighest >= target) {
+                return totalAtHighest > totalAtLowest ? lowest + (target - totalAtLowest) / (totalAtHighest - totalAtLowest) * (highest - lowest) : lowest;
+            }
+        }
+
+        return slopeBelow > 0.0 ? (target - freeBelow) / slopeBelow : 0.0;
+    }
+
+    /**
+     * Finds the expansion scale distributing a target delta, from the threshold histogram.
+     *
+     * @param buckets The expansion threshold histogram.
+     * @param target The delta to distribute over the segments that have an expand ratio.
+     * @return The expansion scale, infinite when every segment saturates before the delta is used.
+     */
+    [[nodiscard]] double ResolveExpandScale(const std::span<const SegmentStreamBucket> buckets, const double target) noexcept {
+        double slopeAbove = 0.0;
+        for (const auto& bucket : buckets) slopeAbove += bucket.slopeSum;
+
+        double boundBelow = 0.0;
+
+        for (const auto& bucket : buckets) {
+            if (bucket.count == 0) continue;
+
+            const double lowest = bucket.lowestThreshold;
+            const double totalAtLowest = boundBelow + slopeAbove * lowest;
+            if (totalAtLowest >= target) {
+                return slopeAbove > 0.0 ? (target - boundBelow) / slopeAbove : lowest;
+            }
+
+            boundBelow += bucket.boundSum;
+            slopeAbove = std::max(0.0, slopeAbove - bucket.slopeSum);
+
+            const double highest = bucket.highestThreshold;
+            const double totalAtHighest = boundBelow + slopeAbove * highest;
+            if (totalAtHighest >= target) {
+                return totalAtHighest > totalAtLowest ? lowest + (target - totalAtLowest) / (totalAtHighest - totalAtLowest) * (highest - lowest) : lowest;
+            }
+        }
+
+        return slopeAbove > 0.0 ? (target - boundBelow) / slopeAbove : std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * Resolves the compression or expansion scale once the first pass is complete.
+     *
+     * The input distance is validated against the accumulated minimum and the mode is chosen
+     * like `Sizing` does. The scale is the water level at which every segment's clamped share
+     * adds up to the input: it matches the cascade whenever no constraint is hit, and otherwise
+     * redistributes clamped remainders over all free segments regardless of their order.
+     *
+     * @param accumulator The accumulator filled by `AccumulateSegmentStream`.
+     * @param inputDistance The distance to distribute.
+     * @return The solution to apply in the second pass.
+     */
+    [[nodiscard]] SegmentStreamSolution ResolveSegmentStream(const SegmentStreamAccumulator& accumulator, const float inputDistance) noexcept {
+        const double validatedInputDistance = std::max<double>(accumulator.accumulatedMin, inputDistance);
+        const bool compressing = validatedInputDistance < accumulator.accumulatedBase;
+
+        const double scale = compressing
+            ? ResolveCompressScale(accumulator.compressThresholds, validatedInputDistance - accumulator.fixedCompressDistance)
+            : ResolveExpandScale(accumulator.expandThresholds, validatedInputDistance - accumulator.accumulatedBase);
+
+        return SegmentStreamSolution{
+            .segmentCount = accumulator.segmentCount,
+            .inputDistance = static_cast<float>(validatedInputDistance),
+            .compressing = compressing,
+            .scale = scale};
+    }
+
+    /**
+     * Second pass: writes the distance and offset of a chunk of records.
+     *
+     * @param solution The solution returned by `ResolveSegmentStream`.
+     * @param records The next chunk of records, in the same order as the first pass.
+     * @param results The results for the chunk, one per record.
+     * @param offset The running offset, advanced past the chunk.
+     */
+    void ApplySegmentStream(const SegmentStreamSolution& solution, const std::span<const SegmentStreamRecord> records, const std::span<SegmentStreamResult> results, double& offset) noexcept {
+        for (size_t i = 0; i < records.size(); ++i) {
+            const auto [validatedMin, validatedMax, validatedBase, compressCapacity, compressSolidify, expandRatio] = ValidateSegmentStreamRecord(records[i]);
+
+            float distance = validatedBase;
+            if (solution.compressing) {
+                const float scaled = compressCapacity > 0.0f ? static_cast<float>(compressSolidify + compressCapacity * solution.scale) : compressSolidify;
+                distance = ChooseGreaterDistance(validatedMin, scaled);
+            }
+            else if (expandRatio > 0.0f) {
+                const float maxDelta = ChooseGreaterDistance(0.0f, validatedMax - validatedBase);
+                distance = validatedBase + static_cast<float>(std::min<double>(expandRatio * solution.scale, maxDelta));
+            }
+
+            results[i] = SegmentStreamResult{.distance = distance, .reserved = 0.0f, .offset = offset};
+            offset += distance;
+        }
+    }
+
+    /**
+     * Solves a segment list stored on disk with two sequential passes and bounded memory.
+     *
+     * The input is a raw array of `SegmentStreamRecord` and the output a raw array of
+     * `SegmentStreamResult` in the same order, offsets running in file order. Only one
+     * chunk of records and results plus the fixed-size threshold histograms are held in
+     * memory, whatever the number of segments. Rounding is not applied.
+     *
+     * @param inputPath The file holding the records.
+     * @param outputPath The file receiving the results; it is overwritten.
+     * @param inputDistance The distance to distribute across all segments.
+     * @param chunkRecords The number of records read per chunk.
+     * @return The resolved solution, or `std::nullopt` if a file could not be read or written.
+     */
+    [[nodiscard]] std::optional<SegmentStreamSolution> SolveSegmentStream(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath, const float inputDistance, const size_t chunkRecords = size_t{1} << 16) {
+        std::ifstream input(inputPath, std::ios::binary);
+        if (!input) return std::nullopt;
+
+        std::vector<SegmentStreamRecord> records(std::max<size_t>(1, chunkRecords));
+        const auto readChunk = [&input, &records]() -> std::optional<std::span<const SegmentStreamRecord>> {
+            input.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SegmentStreamRecord)));
+            const auto bytes = static_cast<size_t>(input.gcount());
+            if (bytes % sizeof(SegmentStreamRecord) != 0 || input.bad()) return std::nullopt;
+            return std::span<const SegmentStreamRecord>(records.data(), bytes / sizeof(SegmentStreamRecord));
+        };
+
+        SegmentStreamAccumulator accumulator;
+        ResetSegmentStream(accumulator);
+
+        while (true) {
+            const auto chunk = readChunk();
+            if (!chunk) return std::nullopt;
+            if (chunk->empty()) break;
+            AccumulateSegmentStream(accumulator, *chunk);
+        }
+
+        const SegmentStreamSolution solution = ResolveSegmentStream(accumulator, inputDistance);
+        accumulator = SegmentStreamAccumulator{};
+
+        input.clear();
+        input.seekg(0);
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if (!input || !output) return std::nullopt;
+
+        std::vector<SegmentStreamResult> results(records.size());
+        double offset = 0.0;
+
+        while (true) {
+            const auto chunk = readChunk();
+            if (!chunk) return std::nullopt;
+            if (chunk->empty()) break;
+
+            const auto chunkResults = std::span(results).first(chunk->size());
+            ApplySegmentStream(solution, *chunk, chunkResults, offset);
+            output.write(reinterpret_cast<const char*>(chunkResults.data()), static_cast<std::streamsize>(chunkResults.size_bytes()));
+            if (!output) return std::nullopt;
+        }
+
+        return solution;
+    }
+
+}
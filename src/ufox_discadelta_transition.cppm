@@ -0,0 +1,121 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+export module ufox_discadelta_transition;
+
+import ufox_discadelta_lib;
+import ufox_discadelta_traversal;
+import ufox_discadelta_simd;
+import ufox_discadelta_export;
+
+export namespace ufox::geometry::discadelta {
+
+    /**
+     * Captures the current placed rects of a subtree as the start state of a transition.
+     *
+     * The visited nodes and their depths are recorded in placement order, and the end state is later
+     * staged from the same nodes, so both states line up element by element even if
+     * the end state places them in another order. The subtree must keep its structure
+     * until the transition is over; only configurations may change.
+     *
+     * @param transition The transition to reset and fill.
+     * @param root The placed root of the animated subtree.
+     * @param leavesOnly Whether only leaf contexts are animated.
+     * @return The number of animated rects.
+     */
+    size_t BeginRectTransition(RectTransition& transition, RectSegmentContext& root, const bool leavesOnly = false) {
+        transition.nodes.clear();
+        transition.depths.clear();
+
+        if (leavesOnly) {
+            for (const auto& [ctx, depth] : TraversePlacedLeaves(root)) {
+                transition.nodes.push_back(ctx);
+                transition.depths.push_back(depth);
+            }
+        }
+        else {
+            for (const auto& [ctx, depth] : TraversePlacementOrder(root)) {
+                transition.nodes.push_back(ctx);
+                transition.depths.push_back(depth);
+            }
+        }
+
+        StageRectExport(std::span<const RectSegmentContext* const>(transition.nodes.data(), transition.nodes.size()), transition.depths, transition.start);
+        ClearRectExportBuffer(transition.end);
+
+        return transition.nodes.size();
+    }
+
+    /**
+     * Captures the placed rects of the recorded nodes as the end state of a transition.
+     *
+     * Call it once the subtree has been solved for its final configuration. From then
+     * on, intermediate frames only blend the two stored states.
+     *
+     * @param transition A transition started with `BeginRectTransition`.
+     */
+    void EndRectTransition(RectTransition& transition) {
+        StageRectExport(std::span<const RectSegmentContext* const>(transition.nodes.data(), transition.nodes.size()), transition.depths, transition.end);
+    }
+
+    /**
+     * Produces the rects of a transition at a given progress without solving.
+     *
+     * Positions and sizes are blended with the SIMD lerp kernel; depth and node id are
+     * taken from the end state. The output is a regular staging buffer, so it can be
+     * passed to the instance and Vulkan export kernels.
+     *
+     * @param transition A transition whose start and end states have been captured.
+     * @param t The progress, clamped to [0, 1]; zero yields the start and one the end state exactly.
+     * @param target The staging buffer receiving the blended rects.
+     * @return The number of blended rects.
+     */
+    size_t InterpolateRectTransition(const RectTransition& transition, const float t, RectExportBuffer& target) {
+        const size_t count = std::min(transition.start.x.size(), transition.end.x.size());
+        const float progress = std::clamp(t, 0.0f, 1.0f);
+
+        target.x.resize(count);
+        target.y.resize(count);
+        target.width.resize(count);
+        target.height.resize(count);
+        target.depth.assign(transition.end.depth.begin(), transition.end.depth.begin() + static_cast<std::ptrdiff_t>(count));
+        target.nodeId.assign(transition.end.nodeId.begin(), transition.end.nodeId.begin() + static_cast<std::ptrdiff_t>(count));
+
+        LerpFloats(std::span(transition.start.x).first(count), std::span(transition.end.x).first(count), progress, target.x);
+        LerpFloats(std::span(transition.start.y).first(count), std::span(transition.end.y).first(count), progress, target.y);
+        LerpFloats(std::span(transition.start.width).first(count), std::span(transition.end.width).first(count), progress, target.width);
+        LerpFloats(std::span(transition.start.height).first(count), std::span(transition.end.height).first(count), progress, target.height);
+
+        return count;
+    }
+
+    /**
+     * Writes the blended rects of a transition back into the animated contexts.
+     *
+     * This lets code that reads `content` directly follow the animation without a
+     * solve per frame. At one, every context holds exactly its solved end state, so a
+     * final `UpdateSegments` is only needed if the tree changed in the meantime.
+     *
+     * @param transition A transition whose start and end states have been captured.
+     * @param t The progress, clamped to [0, 1].
+     * @param staging A reusable staging buffer, owned by the caller.
+     */
+    void ApplyRectTransition(const RectTransition& transition, const float t, RectExportBuffer& staging) {
+        const size_t count = std::min(InterpolateRectTransition(transition, t, staging), transition.nodes.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            RectSegment& content = transition.nodes[i]->content;
+            content.x = staging.x[i];
+            content.y = staging.y[i];
+            content.width = staging.width[i];
+            content.height = staging.height[i];
+        }
+    }
+
+}
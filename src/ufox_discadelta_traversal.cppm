@@ -0,0 +1,244 @@
+//
+// Created by Puwiwad B on 02.01.2026.
+//
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+export module ufox_discadelta_traversal;
+
+import ufox_discadelta_lib;
+
+export namespace ufox::geometry::discadelta {
+
+    enum class TraversalMode {
+        PreOrder,
+        PostOrder,
+        Leaves,
+    };
+
+    enum class SiblingOrder {
+        Storage,
+        Placement,
+    };
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    struct SegmentTraversalNode {
+        ContextT* context{nullptr};
+        size_t depth{0};
+    };
+
+    template<typename ContextT, TraversalMode Mode, SiblingOrder Order>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Forward iterator walking a segment tree without any heap allocation.
+     *
+     * The iterator only stores the traversal root, the current node and its depth.
+     * Moving between siblings uses the `siblingIndex` maintained by the pre-compute
+     * pass, or the `placementOrder` cached by the last `Placing` pass when iterating
+     * in placement order; a parent whose placement order has been invalidated since
+     * then is walked in storage order.
+     */
+    class SegmentTraversalIterator {
+    public:
+        using value_type = SegmentTraversalNode<ContextT>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        SegmentTraversalIterator() = default;
+
+        explicit SegmentTraversalIterator(ContextT* root) noexcept : root(root) {
+            if (root == nullptr) return;
+            current = {root, 0};
+            if constexpr (Mode != TraversalMode::PreOrder) DescendToFirstLeaf();
+        }
+
+        [[nodiscard]] const value_type& operator*() const noexcept { return current; }
+        [[nodiscard]] const value_type* operator->() const noexcept { return &current; }
+
+        SegmentTraversalIterator& operator++() noexcept {
+            if constexpr (Mode == TraversalMode::PreOrder) AdvancePreOrder();
+            else if constexpr (Mode == TraversalMode::PostOrder) AdvancePostOrder();
+            else AdvanceLeaves();
+            return *this;
+        }
+
+        SegmentTraversalIterator operator++(int) noexcept {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(const SegmentTraversalIterator& a, const SegmentTraversalIterator& b) noexcept {
+            return a.current.context == b.current.context;
+        }
+
+    private:
+        ContextT* root{nullptr};
+        value_type current{};
+
+        [[nodiscard]] static bool HasPlacementOrder(const ContextT& ctx) noexcept {
+            return Order == SiblingOrder::Placement && !ctx.children.empty() && ctx.placementOrder.size() == ctx.children.size();
+        }
+
+        [[nodiscard]] static ContextT* FirstChild(const ContextT& ctx) noexcept {
+            if (ctx.children.empty()) return nullptr;
+            return HasPlacementOrder(ctx) ? ctx.children[ctx.placementOrder.front()] : ctx.children.front();
+        }
+
+        [[nodiscard]] static size_t FindSiblingIndex(const ContextT& parent, const ContextT& ctx) noexcept {
+            if (ctx.siblingIndex < parent.children.size() && parent.children[ctx.siblingIndex] == &ctx) return ctx.siblingIndex;
+            return static_cast<size_t>(std::ranges::find(parent.children, &ctx) - parent.children.begin());
+        }
+
+        [[nodiscard]] ContextT* NextSibling(const ContextT& ctx) const noexcept {
+            if (&ctx == root || ctx.parent == nullptr) return nullptr;
+            const ContextT& parent = *ctx.parent;
+
+            if (HasPlacementOrder(parent)) {
+                const size_t next = ctx.placementIndex + 1;
+                return next < parent.placementOrder.size() ? parent.children[parent.placementOrder[next]] : nullptr;
+            }
+
+            const size_t next = FindSiblingIndex(parent, ctx) + 1;
+            return next < parent.children.size() ? parent.children[next] : nullptr;
+        }
+
+        void DescendToFirstLeaf() noexcept {
+            while (ContextT* child = FirstChild(*current.context)) {
+                current = {child, current.depth + 1};
+            }
+        }
+
+        void AdvancePreOrder() noexcept {
+            if (ContextT* child = FirstChild(*current.context)) {
+                current = {child, current.depth + 1};
+                return;
+            }
+
+            for (ContextT* node = current.context; node != root && node->parent != nullptr; node = node->parent) {
+                if (ContextT* sibling = NextSibling(*node)) {
+                    current = {sibling, current.depth};
+                    return;
+                }
+                --current.depth;
+            }
+
+            current = {};
+        }
+
+        void AdvancePostOrder() noexcept {
+            ContextT* node = current.context;
+            if (node == root || node->parent == nullptr) {
+                current = {};
+                return;
+            }
+
+            if (ContextT* sibling = NextSibling(*node)) {
+                current = {sibling, current.depth};
+                DescendToFirstLeaf();
+                return;
+            }
+
+            current = {node->parent, current.depth - 1};
+        }
+
+        void AdvanceLeaves() noexcept {
+            do {
+                AdvancePreOrder();
+            } while (current.context != nullptr && !current.context->children.empty());
+        }
+    };
+
+    template<typename ContextT, TraversalMode Mode, SiblingOrder Order>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Lazy view over a segment tree rooted at a given context.
+     *
+     * The view only holds a pointer to the root; iteration allocates nothing and
+     * yields a `SegmentTraversalNode` carrying the context and its depth relative
+     * to the root. The tree must not be re-linked while a view is being iterated.
+     */
+    class SegmentTraversalView : public std::ranges::view_interface<SegmentTraversalView<ContextT, Mode, Order>> {
+    public:
+        using iterator = SegmentTraversalIterator<ContextT, Mode, Order>;
+
+        SegmentTraversalView() = default;
+        explicit SegmentTraversalView(ContextT& root) noexcept : root(&root) {}
+
+        [[nodiscard]] iterator begin() const noexcept { return iterator{root}; }
+        [[nodiscard]] iterator end() const noexcept { return iterator{}; }
+
+    private:
+        ContextT* root{nullptr};
+    };
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Creates a view visiting every node before its children, in storage order.
+     *
+     * @param root The context at which the traversal starts, visited at depth zero.
+     * @return A lazy pre-order view over the subtree.
+     */
+    [[nodiscard]] constexpr auto TraversePreOrder(ContextT& root) noexcept {
+        return SegmentTraversalView<ContextT, TraversalMode::PreOrder, SiblingOrder::Storage>{root};
+    }
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Creates a view visiting every node after its children, in storage order.
+     *
+     * @param root The context at which the traversal starts, visited last at depth zero.
+     * @return A lazy post-order view over the subtree.
+     */
+    [[nodiscard]] constexpr auto TraversePostOrder(ContextT& root) noexcept {
+        return SegmentTraversalView<ContextT, TraversalMode::PostOrder, SiblingOrder::Storage>{root};
+    }
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Creates a pre-order view whose siblings follow the order used by the last `Placing` pass.
+     *
+     * This is the order in which segments are laid out along their parent's axis, so
+     * offsets increase monotonically between consecutive siblings.
+     *
+     * @param root The context at which the traversal starts, visited at depth zero.
+     * @return A lazy placement-order view over the subtree.
+     */
+    [[nodiscard]] constexpr auto TraversePlacementOrder(ContextT& root) noexcept {
+        return SegmentTraversalView<ContextT, TraversalMode::PreOrder, SiblingOrder::Placement>{root};
+    }
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Creates a view visiting only the leaves of a subtree, in storage order.
+     *
+     * @param root The context at which the traversal starts; a childless root is its own leaf.
+     * @return A lazy view over the leaves of the subtree.
+     */
+    [[nodiscard]] constexpr auto TraverseLeaves(ContextT& root) noexcept {
+        return SegmentTraversalView<ContextT, TraversalMode::Leaves, SiblingOrder::Storage>{root};
+    }
+
+    template<typename ContextT>
+    requires std::same_as<std::remove_const_t<ContextT>, LinearSegmentContext> || std::same_as<std::remove_const_t<ContextT>, RectSegmentContext>
+    /**
+     * Creates a view visiting only the leaves of a subtree, in placement order.
+     *
+     * @param root The context at which the traversal starts; a childless root is its own leaf.
+     * @return A lazy view over the leaves of the subtree, as they are laid out.
+     */
+    [[nodiscard]] constexpr auto TraversePlacedLeaves(ContextT& root) noexcept {
+        return SegmentTraversalView<ContextT, TraversalMode::Leaves, SiblingOrder::Placement>{root};
+    }
+
+}